@@ -0,0 +1,111 @@
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <optional>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+
+namespace {
+
+using namespace lf;
+
+inline constexpr int channel_producers = 16;
+inline constexpr int channel_consumers = 16;
+inline constexpr long channel_msgs = 10'000;
+
+constexpr auto produce = [](auto produce, channel<long> *ch, int width, bool root) LF_STATIC_CALL -> task<> {
+  //
+  if (width > 1) {
+    co_await lf::fork(produce)(ch, width / 2, false);
+    co_await lf::call(produce)(ch, width - width / 2, false);
+    co_await lf::join;
+  } else {
+    for (long i = 0; i < channel_msgs; ++i) {
+      benchmark::DoNotOptimize(co_await ch->send(i));
+    }
+  }
+
+  if (root) {
+    ch->close();
+  }
+};
+
+constexpr auto consume = [](auto consume, channel<long> *ch, int width) LF_STATIC_CALL -> task<long> {
+  //
+  if (width > 1) {
+
+    long a, b;
+
+    co_await lf::fork(&a, consume)(ch, width / 2);
+    co_await lf::call(&b, consume)(ch, width - width / 2);
+    co_await lf::join;
+
+    co_return a + b;
+  }
+
+  long sum = 0;
+
+  while (std::optional<long> val = co_await ch->recv()) {
+    sum += *val;
+  }
+
+  co_return sum;
+};
+
+constexpr auto produce_consume = [](auto, channel<long> *ch) LF_STATIC_CALL -> task<long> {
+  //
+  long sum;
+
+  co_await lf::fork(&sum, consume)(ch, channel_consumers);
+  co_await lf::call(produce)(ch, channel_producers, true);
+
+  co_await lf::join;
+
+  co_return sum;
+};
+
+/**
+ * @brief Throughput of a channel with `Capacity` slots (zero for unbounded) between task trees.
+ */
+template <lf::scheduler Sch, lf::numa_strategy Strategy, std::size_t Capacity>
+void channel_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["capacity"] = Capacity;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  volatile long output;
+
+  for (auto _ : state) {
+    channel<long> ch{Capacity == 0 ? channel<long>::unbounded : Capacity};
+    output = lf::sync_wait(sch, produce_consume, &ch);
+  }
+
+  long msgs = channel_producers * channel_msgs;
+
+  state.SetItemsProcessed(state.iterations() * msgs);
+
+  if (long expect = channel_producers * (channel_msgs * (channel_msgs - 1) / 2); output != expect) {
+    std::cerr << "lf wrong answer: " << output << " != " << expect << std::endl;
+  }
+}
+
+} // namespace
+
+using namespace lf;
+
+BENCHMARK(channel_libfork<lazy_pool, numa_strategy::fan, 1>)->Apply(targs)->UseRealTime();
+BENCHMARK(channel_libfork<lazy_pool, numa_strategy::fan, 64>)->Apply(targs)->UseRealTime();
+BENCHMARK(channel_libfork<lazy_pool, numa_strategy::fan, 0>)->Apply(targs)->UseRealTime();
+BENCHMARK(channel_libfork<busy_pool, numa_strategy::fan, 64>)->Apply(targs)->UseRealTime();
@@ -0,0 +1,66 @@
+#ifndef E6B1A2C9_4F3D_4A87_B5E0_2C9D8F1A7B35
+#define E6B1A2C9_4F3D_4A87_B5E0_2C9D8F1A7B35
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+// A wavefront: cell (i, j) of a dim x dim grid depends on (i - 1, j) and (i, j - 1).
+
+inline constexpr int dim = 64;
+inline constexpr int work = 2048;
+
+/**
+ * @brief Combine the values of the cells above and left of a cell, `work` rounds of hashing.
+ */
+inline constexpr auto cell(std::uint64_t up, std::uint64_t left) -> std::uint64_t {
+
+  std::uint64_t x = up ^ (left << 1);
+
+  for (int i = 0; i < work; ++i) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+  }
+
+  return x;
+}
+
+/**
+ * @brief The value of cell (i, j) given the grid, out of bounds cells have value i + j.
+ */
+inline auto at(std::vector<std::uint64_t> const &grid, int i, int j) -> std::uint64_t {
+  if (i < 0 || j < 0) {
+    return static_cast<std::uint64_t>(i + j);
+  }
+  return grid[static_cast<std::size_t>(i * dim + j)];
+}
+
+inline void update(std::vector<std::uint64_t> &grid, int i, int j) {
+  grid[static_cast<std::size_t>(i * dim + j)] = cell(at(grid, i - 1, j), at(grid, i, j - 1));
+}
+
+inline auto dag_serial_result() -> std::uint64_t {
+
+  std::vector<std::uint64_t> grid(dim * dim);
+
+  for (int i = 0; i < dim; ++i) {
+    for (int j = 0; j < dim; ++j) {
+      update(grid, i, j);
+    }
+  }
+
+  return grid.back();
+}
+
+inline void dag_check(std::vector<std::uint64_t> const &grid) {
+  if (grid.back() != dag_serial_result()) {
+    std::cout << "error: " << grid.back() << "!=" << dag_serial_result() << std::endl;
+  }
+}
+
+#endif /* E6B1A2C9_4F3D_4A87_B5E0_2C9D8F1A7B35 */
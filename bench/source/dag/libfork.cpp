@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+using namespace lf;
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy>
+void dag_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["dag_dim"] = dim;
+  state.counters["dag_work"] = work;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0), Strategy);
+    } else {
+      return Sch{};
+    }
+  }();
+
+  std::vector<std::uint64_t> grid(dim * dim);
+
+  // Built once, run every iteration.
+
+  task_graph graph;
+
+  std::vector<task_graph::node> nodes;
+
+  for (int i = 0; i < dim; ++i) {
+    for (int j = 0; j < dim; ++j) {
+      nodes.push_back(graph.emplace([&grid, i, j] {
+        update(grid, i, j);
+      }));
+      if (i > 0) {
+        graph.precede(nodes[static_cast<std::size_t>((i - 1) * dim + j)], nodes.back());
+      }
+      if (j > 0) {
+        graph.precede(nodes[static_cast<std::size_t>(i * dim + j - 1)], nodes.back());
+      }
+    }
+  }
+
+  for (auto _ : state) {
+    sync_wait(sch, run_graph, graph);
+    benchmark::DoNotOptimize(grid.data());
+  }
+
+#ifndef LF_NO_CHECK
+  dag_check(grid);
+#endif
+}
+
+} // namespace
+
+using namespace lf;
+
+BENCHMARK(dag_libfork<lazy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
+BENCHMARK(dag_libfork<busy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
+BENCHMARK(dag_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(dag_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+
+#include "config.hpp"
+
+namespace {
+
+void dag_serial(benchmark::State &state) {
+
+  state.counters["green_threads"] = 1;
+  state.counters["dag_dim"] = dim;
+  state.counters["dag_work"] = work;
+
+  std::vector<std::uint64_t> grid(dim * dim);
+
+  for (auto _ : state) {
+    for (int i = 0; i < dim; ++i) {
+      for (int j = 0; j < dim; ++j) {
+        update(grid, i, j);
+      }
+    }
+    benchmark::DoNotOptimize(grid.data());
+  }
+
+#ifndef LF_NO_CHECK
+  dag_check(grid);
+#endif
+}
+
+} // namespace
+
+BENCHMARK(dag_serial)->UseRealTime();
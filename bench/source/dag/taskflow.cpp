@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <taskflow/taskflow.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void dag_ztaskflow(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["dag_dim"] = dim;
+  state.counters["dag_work"] = work;
+
+  std::vector<std::uint64_t> grid(dim * dim);
+
+  tf::Executor executor(state.range(0));
+
+  tf::Taskflow taskflow;
+
+  std::vector<tf::Task> nodes;
+
+  for (int i = 0; i < dim; ++i) {
+    for (int j = 0; j < dim; ++j) {
+      nodes.push_back(taskflow.emplace([&grid, i, j] {
+        update(grid, i, j);
+      }));
+      if (i > 0) {
+        nodes[static_cast<std::size_t>((i - 1) * dim + j)].precede(nodes.back());
+      }
+      if (j > 0) {
+        nodes[static_cast<std::size_t>(i * dim + j - 1)].precede(nodes.back());
+      }
+    }
+  }
+
+  for (auto _ : state) {
+    executor.run(taskflow).wait();
+    benchmark::DoNotOptimize(grid.data());
+  }
+
+#ifndef LF_NO_CHECK
+  dag_check(grid);
+#endif
+}
+
+} // namespace
+
+BENCHMARK(dag_ztaskflow)->Apply(targs)->UseRealTime();
@@ -0,0 +1,23 @@
+#ifndef F3BCCFC2_E283_4C7E_83AA_FAB2B97286E5
+#define F3BCCFC2_E283_4C7E_83AA_FAB2B97286E5
+
+#include <vector>
+
+inline constexpr std::size_t dot_n /**/ = 1'000'000;
+inline constexpr std::size_t dot_chunk = dot_n / 32;
+inline constexpr std::size_t dot_reps = 1'000;
+
+inline auto make_vec_dot(double scale) -> std::vector<double> {
+
+  std::vector<double> out(dot_n);
+
+  unsigned count = 0;
+
+  for (auto &&elem : out) {
+    elem = scale * (++count % 16);
+  }
+
+  return out;
+}
+
+#endif /* F3BCCFC2_E283_4C7E_83AA_FAB2B97286E5 */
@@ -0,0 +1,67 @@
+#include <functional>
+#include <iostream>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+using namespace lf;
+
+namespace {
+
+// Not a well-known operator hence, reduced with a single accumulator per chunk.
+constexpr auto opaque_plus = [](double a, double b) -> double {
+  return a + b;
+};
+
+template <bool Lanes>
+constexpr auto repeat = [](auto, std::vector<double> const &x, std::vector<double> const &y) //
+    -> lf::task<double> {
+  double sum = 0;
+
+  for (std::size_t i = 0; i < dot_reps; ++i) {
+    if constexpr (Lanes) {
+      sum += co_await lf::just(lf::transform_reduce)(x, y.begin(), dot_chunk, 0.0);
+    } else {
+      sum += co_await lf::just(lf::transform_reduce)(
+          x, y.begin(), dot_chunk, 0.0, opaque_plus, std::multiplies<>{} //
+      );
+    }
+  }
+
+  co_return sum;
+};
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, bool Lanes = true>
+void dot_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = dot_n;
+  state.counters["reps"] = dot_reps;
+  state.counters["chunk"] = dot_chunk;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  std::vector<double> x = lf::sync_wait(sch, lf::lift, make_vec_dot, 1);
+  std::vector<double> y = lf::sync_wait(sch, lf::lift, make_vec_dot, 0.5);
+
+  volatile double sink = 0;
+
+  for (auto _ : state) {
+    sink = lf::sync_wait(sch, repeat<Lanes>, x, y);
+  }
+}
+
+} // namespace
+
+BENCHMARK(dot_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(dot_libfork<lazy_pool, numa_strategy::fan, false>)->Apply(targs)->UseRealTime();
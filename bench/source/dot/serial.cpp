@@ -0,0 +1,34 @@
+#include <functional>
+#include <iostream>
+#include <numeric>
+
+#include <benchmark/benchmark.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void dot_serial(benchmark::State &state) {
+
+  state.counters["dot(n)"] = dot_n;
+
+  std::vector<double> x = make_vec_dot(1);
+  std::vector<double> y = make_vec_dot(0.5);
+
+  volatile double sink = 0;
+
+  double sum = 0;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < dot_reps; ++i) {
+      sum += std::transform_reduce(x.begin(), x.end(), y.begin(), 0.0);
+    }
+  }
+
+  sink = sum;
+}
+
+} // namespace
+
+BENCHMARK(dot_serial)->UseRealTime();
@@ -51,7 +51,24 @@ inline constexpr auto matmul = [](auto matmul, mat A, mat B, mat R, unsigned n,
   co_await join;
 };
 
-template <lf::scheduler Sch, lf::numa_strategy Strategy>
+/**
+ * @brief Tile the output with `lf::for_each` over a `blocked_range2d`, each tile is an independent block.
+ */
+inline void matmul_tile(mat A, mat B, mat R, int n, blocked_range2d<int> tile) {
+  for (int i : tile.indices(0)) {
+    for (int k : tile.indices(1)) {
+      R[i * n + k] = 0;
+    }
+    for (int j = 0; j < n; j++) {
+      float a = A[i * n + j];
+      for (int k : tile.indices(1)) {
+        R[i * n + k] += a * B[j * n + k];
+      }
+    }
+  }
+}
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, bool Tiled = false>
 void matmul_libfork(benchmark::State &state) {
 
   state.counters["green_threads"] = state.range(0);
@@ -68,7 +85,13 @@ void matmul_libfork(benchmark::State &state) {
   auto [A, B, C1, C2, n] = lf::sync_wait(sch, lf::lift, matmul_init, matmul_work);
 
   for (auto _ : state) {
-    lf::sync_wait(sch, matmul, A.get(), B.get(), C1.get(), n, n, std::false_type{});
+    if constexpr (Tiled) {
+      lf::sync_wait(sch, lf::for_each, blocked_range2d<int>{{0, 0}, {n, n}, {32, 32}}, [&](auto tile) {
+        matmul_tile(A.get(), B.get(), C1.get(), n, tile);
+      });
+    } else {
+      lf::sync_wait(sch, matmul, A.get(), B.get(), C1.get(), n, n, std::false_type{});
+    }
   }
 
 #ifndef LF_NO_CHECK
@@ -91,4 +114,7 @@ BENCHMARK(matmul_libfork<lazy_pool, numa_strategy::seq>)->Apply(targs)->UseRealT
 BENCHMARK(matmul_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
 
 BENCHMARK(matmul_libfork<busy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
-BENCHMARK(matmul_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
\ No newline at end of file
+BENCHMARK(matmul_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+
+BENCHMARK(matmul_libfork<lazy_pool, numa_strategy::seq, true>)->Apply(targs)->UseRealTime();
+BENCHMARK(matmul_libfork<busy_pool, numa_strategy::seq, true>)->Apply(targs)->UseRealTime();
@@ -0,0 +1,94 @@
+#include <concepts>
+#include <iostream>
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+
+namespace {
+
+using namespace lf;
+
+inline constexpr int mutex_tasks = 1024;
+inline constexpr int mutex_ops = 256;
+
+/**
+ * @brief A little work inside/outside the critical section.
+ */
+inline auto spin_work(int n) -> int {
+  int x = 0;
+  for (int i = 0; i < n; ++i) {
+    benchmark::DoNotOptimize(x += i);
+  }
+  return x;
+}
+
+/**
+ * @brief `width` tasks each increment a shared counter `mutex_ops` times under `Mutex`.
+ */
+template <typename Mutex>
+constexpr auto contend = [](auto contend, Mutex *mtx, long *count, int width) LF_STATIC_CALL -> task<> {
+  //
+  if (width > 1) {
+    co_await lf::fork(contend)(mtx, count, width / 2);
+    co_await lf::call(contend)(mtx, count, width - width / 2);
+    co_await lf::join;
+    co_return;
+  }
+
+  for (int i = 0; i < mutex_ops; ++i) {
+
+    if constexpr (std::same_as<Mutex, lf::mutex>) {
+      co_await mtx->lock();
+    } else {
+      mtx->lock();
+    }
+
+    *count += spin_work(8);
+
+    mtx->unlock();
+
+    spin_work(64);
+  }
+};
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, typename Mutex>
+void mutex_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["tasks"] = mutex_tasks;
+  state.counters["ops"] = mutex_ops;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  Mutex mtx;
+  long count = 0;
+
+  for (auto _ : state) {
+    lf::sync_wait(sch, contend<Mutex>, &mtx, &count, mutex_tasks);
+  }
+
+  long expect = static_cast<long>(state.iterations()) * mutex_tasks * mutex_ops * spin_work(8);
+
+  if (count != expect) {
+    std::cerr << "lf wrong answer: " << count << " != " << expect << std::endl;
+  }
+}
+
+} // namespace
+
+using namespace lf;
+
+BENCHMARK(mutex_libfork<lazy_pool, numa_strategy::fan, lf::mutex>)->Apply(targs)->UseRealTime();
+BENCHMARK(mutex_libfork<lazy_pool, numa_strategy::fan, std::mutex>)->Apply(targs)->UseRealTime();
+BENCHMARK(mutex_libfork<busy_pool, numa_strategy::fan, lf::mutex>)->Apply(targs)->UseRealTime();
+BENCHMARK(mutex_libfork<busy_pool, numa_strategy::fan, std::mutex>)->Apply(targs)->UseRealTime();
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <exception>
 #include <iostream>
 #include <numeric>
@@ -71,6 +72,88 @@ void nqueens_libfork(benchmark::State &state) {
   }
 }
 
+/**
+ * @brief Search for the first solution, if `cancel` then the search is stopped when one is found.
+ *
+ * Every visited node is counted in `nodes`, nodes visited after the first solution is found are wasted work.
+ */
+constexpr auto nqueens_first = []<std::size_t N>(auto nqueens_first,
+                                                 int j,
+                                                 std::array<char, N> const &a,
+                                                 bool cancel,
+                                                 std::atomic_long *nodes) LF_STATIC_CALL -> task<int> {
+  //
+  // Forks with a return address run even once cancelled, hence the explicit polling.
+  if (cancel && co_await lf::cancelled()) {
+    co_return 0;
+  }
+
+  nodes->fetch_add(1, std::memory_order_relaxed);
+
+  if (N == j) {
+    if (cancel) {
+      co_await lf::request_stop();
+    }
+    co_return 1;
+  }
+
+  std::array<std::array<char, N>, N> buf;
+  std::array<int, N> parts{};
+
+  for (int i = 0; i < N; i++) {
+
+    for (int k = 0; k < j; k++) {
+      buf[i][k] = a[k];
+    }
+
+    buf[i][j] = i;
+
+    if (cancel && co_await lf::cancelled()) {
+      break;
+    }
+
+    if (queens_ok(j + 1, buf[i].data())) {
+      co_await lf::fork(&parts[i], nqueens_first)(j + 1, buf[i], cancel, nodes);
+    }
+  }
+
+  co_await lf::join;
+
+  co_return std::accumulate(parts.begin(), parts.end(), 0L);
+};
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, bool Cancel>
+void nqueens_first_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["nqueens(n)"] = nqueens_work;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  volatile int output;
+
+  std::array<char, nqueens_work> buf{};
+
+  std::atomic_long nodes = 0;
+
+  for (auto _ : state) {
+    output = lf::sync_wait(sch, nqueens_first, 0, buf, Cancel, &nodes);
+  }
+
+  // Visited nodes per iteration, the difference between the two variants is the wasted work.
+  state.counters["nodes"] = static_cast<double>(nodes.load()) / static_cast<double>(state.iterations());
+
+  if (output < 1) {
+    std::cerr << "lf found no solution!" << std::endl;
+  }
+}
+
 } // namespace
 
 using namespace lf;
@@ -79,3 +162,6 @@ BENCHMARK(nqueens_libfork<lazy_pool, numa_strategy::seq>)->Apply(targs)->UseReal
 BENCHMARK(nqueens_libfork<busy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
 BENCHMARK(nqueens_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
 BENCHMARK(nqueens_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+
+BENCHMARK(nqueens_first_libfork<lazy_pool, numa_strategy::fan, false>)->Apply(targs)->UseRealTime();
+BENCHMARK(nqueens_first_libfork<lazy_pool, numa_strategy::fan, true>)->Apply(targs)->UseRealTime();
@@ -0,0 +1,58 @@
+#ifndef A9E4C7B2_1D58_4F36_8B0A_3E7F2C6D9B41
+#define A9E4C7B2_1D58_4F36_8B0A_3E7F2C6D9B41
+
+#include <cstdint>
+#include <iostream>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+// A stream of records: parse (serial, in order), transform (parallel), write (serial, in order).
+
+inline constexpr int records = 1 << 14;
+inline constexpr int work = 2048;
+inline constexpr int tokens_per_thread = 4;
+
+/**
+ * @brief Produce record `i`, cheap.
+ */
+inline constexpr auto parse(int i) -> std::uint64_t {
+  return static_cast<std::uint64_t>(i) * 0x9e3779b97f4a7c15ULL;
+}
+
+/**
+ * @brief The expensive part, `work` rounds of hashing.
+ */
+inline constexpr auto transform(std::uint64_t x) -> std::uint64_t {
+  for (int i = 0; i < work; ++i) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+  }
+  return x;
+}
+
+/**
+ * @brief Fold a record into the output, the result depends on the order.
+ */
+inline constexpr auto write(std::uint64_t acc, std::uint64_t x) -> std::uint64_t { return acc * 31 + x; }
+
+inline auto pipeline_serial_result() -> std::uint64_t {
+
+  std::uint64_t acc = 0;
+
+  for (int i = 0; i < records; ++i) {
+    acc = write(acc, transform(parse(i)));
+  }
+
+  return acc;
+}
+
+inline void pipeline_check(std::uint64_t out) {
+  if (out != pipeline_serial_result()) {
+    std::cout << "error: " << out << "!=" << pipeline_serial_result() << std::endl;
+  }
+}
+
+#endif /* A9E4C7B2_1D58_4F36_8B0A_3E7F2C6D9B41 */
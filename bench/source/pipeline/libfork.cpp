@@ -0,0 +1,71 @@
+#include <cstddef>
+#include <optional>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+using namespace lf;
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy>
+void pipeline_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["pipeline_records"] = records;
+  state.counters["pipeline_work"] = work;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0), Strategy);
+    } else {
+      return Sch{};
+    }
+  }();
+
+  auto tokens = static_cast<std::size_t>(tokens_per_thread * state.range(0));
+
+  std::uint64_t out = 0;
+
+  for (auto _ : state) {
+
+    int i = 0;
+
+    out = 0;
+
+    auto source = [&]() -> std::optional<std::uint64_t> {
+      if (i == records) {
+        return std::nullopt;
+      }
+      return parse(i++);
+    };
+
+    sync_wait(sch,
+              pipeline,
+              tokens,
+              source,
+              stage<stage_mode::parallel>(transform),
+              stage<stage_mode::serial_in_order>([&](std::uint64_t x) {
+                out = write(out, x);
+              }));
+
+    benchmark::DoNotOptimize(out);
+  }
+
+#ifndef LF_NO_CHECK
+  pipeline_check(out);
+#endif
+}
+
+} // namespace
+
+using namespace lf;
+
+BENCHMARK(pipeline_libfork<lazy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
+BENCHMARK(pipeline_libfork<busy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
+BENCHMARK(pipeline_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(pipeline_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include "config.hpp"
+
+namespace {
+
+void pipeline_serial(benchmark::State &state) {
+
+  state.counters["green_threads"] = 1;
+  state.counters["pipeline_records"] = records;
+  state.counters["pipeline_work"] = work;
+
+  volatile int confuse = records;
+
+  std::uint64_t out = 0;
+
+  for (auto _ : state) {
+    out = 0;
+    for (int i = 0; i < confuse; ++i) {
+      out = write(out, transform(parse(i)));
+    }
+    benchmark::DoNotOptimize(out);
+  }
+
+#ifndef LF_NO_CHECK
+  pipeline_check(out);
+#endif
+}
+
+} // namespace
+
+BENCHMARK(pipeline_serial)->UseRealTime();
@@ -0,0 +1,60 @@
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include <tbb/parallel_pipeline.h>
+#include <tbb/task_arena.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void pipeline_tbb(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["pipeline_records"] = records;
+  state.counters["pipeline_work"] = work;
+
+  tbb::task_arena arena(state.range(0));
+
+  auto tokens = static_cast<std::size_t>(tokens_per_thread * state.range(0));
+
+  std::uint64_t out = 0;
+
+  for (auto _ : state) {
+
+    int i = 0;
+
+    out = 0;
+
+    arena.execute([&] {
+      tbb::parallel_pipeline(
+          tokens,
+          tbb::make_filter<void, std::uint64_t>(tbb::filter_mode::serial_in_order,
+                                                [&](tbb::flow_control &fc) -> std::uint64_t {
+                                                  if (i == records) {
+                                                    fc.stop();
+                                                    return 0;
+                                                  }
+                                                  return parse(i++);
+                                                }) &
+              tbb::make_filter<std::uint64_t, std::uint64_t>(tbb::filter_mode::parallel, [](std::uint64_t x) {
+                return transform(x);
+              }) &
+              tbb::make_filter<std::uint64_t, void>(tbb::filter_mode::serial_in_order, [&](std::uint64_t x) {
+                out = write(out, x);
+              }));
+    });
+
+    benchmark::DoNotOptimize(out);
+  }
+
+#ifndef LF_NO_CHECK
+  pipeline_check(out);
+#endif
+}
+
+} // namespace
+
+BENCHMARK(pipeline_tbb)->Apply(targs)->UseRealTime();
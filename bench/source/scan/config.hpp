@@ -22,9 +22,14 @@ inline constexpr std::size_t scan_n /**/ = 8'000;
 inline constexpr std::size_t scan_chunk = scan_n / 3;
 inline constexpr std::size_t scan_reps = 100'000;
 
-inline auto make_vec() -> std::vector<unsigned> {
+// Well beyond the last level cache, for comparing the tree and single pass scans.
+inline constexpr std::size_t scan_big_n /**/ = 64'000'000;
+inline constexpr std::size_t scan_big_chunk = scan_big_n / 128;
+inline constexpr std::size_t scan_big_reps = 10;
 
-  std::vector<unsigned> out(scan_n);
+inline auto make_vec(std::size_t n) -> std::vector<unsigned> {
+
+  std::vector<unsigned> out(n);
 
   unsigned count = 0;
 
@@ -35,4 +40,6 @@ inline auto make_vec() -> std::vector<unsigned> {
   return out;
 }
 
+inline auto make_vec() -> std::vector<unsigned> { return make_vec(scan_n); }
+
 #endif /* C39D8802_9977_423A_88EB_5816761ED5A8 */
@@ -12,15 +12,46 @@ using namespace lf;
 
 namespace {
 
+// Not a well-known operator hence, scanned with the scalar leaves.
+constexpr auto opaque_plus = [](unsigned a, unsigned b) -> unsigned {
+  return a + b;
+};
+
+template <bool Lazy, bool Vector>
 constexpr auto repeat = [](auto, unsigned const * in, unsigned * ou) -> lf::task<void> {
+
+  auto bop = [] {
+    if constexpr (Vector) {
+      return std::plus<>{};
+    } else {
+      return opaque_plus;
+    }
+  }();
+
   for (std::size_t i = 0; i < scan_reps; ++i) {
     // std::inclusive_scan(in, in + scan_n, ou, std::plus<>{}); ///
-    co_await lf::just(lf::scan)(in, in + scan_n, ou, scan_chunk, std::plus<>{}); 
+    if constexpr (Lazy) {
+      co_await lf::just(lf::scan)(in, in + scan_n, ou, lf::lazy_split, bop);
+    } else {
+      co_await lf::just(lf::scan)(in, in + scan_n, ou, scan_chunk, bop); 
+    }
   }
   co_return;
 };
 
-template <lf::scheduler Sch, lf::numa_strategy Strategy>
+template <bool SinglePass>
+constexpr auto repeat_big = [](auto, unsigned const * in, unsigned * ou) -> lf::task<void> {
+  for (std::size_t i = 0; i < scan_big_reps; ++i) {
+    if constexpr (SinglePass) {
+      co_await lf::just(lf::scan)(in, in + scan_big_n, ou, lf::single_pass, std::plus<>{});
+    } else {
+      co_await lf::just(lf::scan)(in, in + scan_big_n, ou, scan_big_chunk, std::plus<>{});
+    }
+  }
+  co_return;
+};
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, bool Lazy = false, bool Vector = true>
 void scan_libfork(benchmark::State &state) {
 
   state.counters["green_threads"] = static_cast<double>(state.range(0));
@@ -36,7 +67,42 @@ void scan_libfork(benchmark::State &state) {
     }
   }();
 
-  std::vector in = lf::sync_wait(sch, lf::lift, make_vec);
+  std::vector in = lf::sync_wait(sch, lf::lift, [] {
+    return make_vec();
+  });
+
+  std::vector ou = lf::sync_wait(sch, lf::lift, [&] {
+    return std::vector{in};
+  });
+
+  volatile unsigned sink = 0;
+
+  for (auto _ : state) {
+    lf::sync_wait(sch, repeat<Lazy, Vector>, in.data(), ou.data());
+  }
+
+  sink = ou.back();
+}
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, bool SinglePass>
+void scan_big_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = scan_big_n;
+  state.counters["reps"] = scan_big_reps;
+  state.counters["chunk"] = SinglePass ? lf::single_pass.chunk : scan_big_chunk;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  std::vector in = lf::sync_wait(sch, lf::lift, [] {
+    return make_vec(scan_big_n);
+  });
 
   std::vector ou = lf::sync_wait(sch, lf::lift, [&] {
     return std::vector{in};
@@ -45,7 +111,7 @@ void scan_libfork(benchmark::State &state) {
   volatile unsigned sink = 0;
 
   for (auto _ : state) {
-    lf::sync_wait(sch, repeat, in.data(), ou.data());
+    lf::sync_wait(sch, repeat_big<SinglePass>, in.data(), ou.data());
   }
 
   sink = ou.back();
@@ -55,6 +121,11 @@ void scan_libfork(benchmark::State &state) {
 
 // BENCHMARK(scan_libfork<lazy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
 BENCHMARK(scan_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(scan_libfork<lazy_pool, numa_strategy::fan, true>)->Apply(targs)->UseRealTime();
+BENCHMARK(scan_libfork<lazy_pool, numa_strategy::fan, false, false>)->Apply(targs)->UseRealTime();
 
 // BENCHMARK(scan_libfork<busy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
-// BENCHMARK(scan_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
\ No newline at end of file
+// BENCHMARK(scan_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+
+BENCHMARK(scan_big_libfork<lazy_pool, numa_strategy::fan, false>)->Apply(targs)->UseRealTime();
+BENCHMARK(scan_big_libfork<lazy_pool, numa_strategy::fan, true>)->Apply(targs)->UseRealTime();
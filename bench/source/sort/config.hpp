@@ -0,0 +1,38 @@
+#ifndef E4B19C62_7A3D_4F85_9D20_6C1F8A5E3B97
+#define E4B19C62_7A3D_4F85_9D20_6C1F8A5E3B97
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+inline constexpr std::size_t sort_n = 1'000'000;
+
+/**
+ * @brief The same pseudo-random input each time.
+ */
+inline auto make_vec_sort() -> std::vector<std::uint64_t> {
+
+  std::vector<std::uint64_t> out(sort_n);
+
+  std::uint64_t x = 0x9e3779b97f4a7c15ULL;
+
+  for (auto &&elem : out) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    elem = x;
+  }
+
+  return out;
+}
+
+inline void check_sort([[maybe_unused]] std::vector<std::uint64_t> const &out) {
+#ifndef LF_NO_CHECK
+  if (!std::ranges::is_sorted(out)) {
+    throw std::runtime_error("Sort failed");
+  }
+#endif
+}
+
+#endif /* E4B19C62_7A3D_4F85_9D20_6C1F8A5E3B97 */
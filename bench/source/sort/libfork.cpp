@@ -0,0 +1,81 @@
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+using namespace lf;
+
+namespace {
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, bool Stable>
+void sort_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["sort(n)"] = sort_n;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0), Strategy);
+    } else {
+      return Sch{};
+    }
+  }();
+
+  std::vector in = lf::sync_wait(sch, lf::lift, make_vec_sort);
+  std::vector out = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    out = in;
+    state.ResumeTiming();
+    if constexpr (Stable) {
+      lf::sync_wait(sch, lf::stable_sort, out);
+    } else {
+      lf::sync_wait(sch, lf::sort, out);
+    }
+  }
+
+  check_sort(out);
+}
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy>
+void radix_sort_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["sort(n)"] = sort_n;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0), Strategy);
+    } else {
+      return Sch{};
+    }
+  }();
+
+  std::vector in = lf::sync_wait(sch, lf::lift, make_vec_sort);
+  std::vector out = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    out = in;
+    state.ResumeTiming();
+    lf::sync_wait(sch, lf::radix_sort, out);
+  }
+
+  check_sort(out);
+}
+
+} // namespace
+
+BENCHMARK(sort_libfork<lazy_pool, numa_strategy::fan, false>)->Apply(targs)->UseRealTime();
+BENCHMARK(sort_libfork<busy_pool, numa_strategy::fan, false>)->Apply(targs)->UseRealTime();
+
+BENCHMARK(sort_libfork<lazy_pool, numa_strategy::fan, true>)->Apply(targs)->UseRealTime();
+BENCHMARK(sort_libfork<busy_pool, numa_strategy::fan, true>)->Apply(targs)->UseRealTime();
+
+BENCHMARK(radix_sort_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(radix_sort_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
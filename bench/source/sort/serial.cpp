@@ -0,0 +1,47 @@
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void sort_serial(benchmark::State &state) {
+
+  state.counters["sort(n)"] = sort_n;
+
+  std::vector in = make_vec_sort();
+  std::vector out = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    out = in;
+    state.ResumeTiming();
+    std::ranges::sort(out);
+  }
+
+  check_sort(out);
+}
+
+void stable_sort_serial(benchmark::State &state) {
+
+  state.counters["stable_sort(n)"] = sort_n;
+
+  std::vector in = make_vec_sort();
+  std::vector out = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    out = in;
+    state.ResumeTiming();
+    std::ranges::stable_sort(out);
+  }
+
+  check_sort(out);
+}
+
+} // namespace
+
+BENCHMARK(sort_serial)->UseRealTime();
+BENCHMARK(stable_sort_serial)->UseRealTime();
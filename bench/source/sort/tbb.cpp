@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <execution>
+
+#include <benchmark/benchmark.h>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void sort_tbb(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["sort(n)"] = sort_n;
+
+  std::size_t n = state.range(0);
+  tbb::task_arena arena(n);
+
+  std::vector in = make_vec_sort();
+  std::vector out = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    out = in;
+    state.ResumeTiming();
+    arena.execute([&] {
+      tbb::parallel_sort(out.begin(), out.end());
+    });
+  }
+
+  check_sort(out);
+}
+
+// The standard parallel algorithms (libstdc++) are backed by TBB, limit the workers to `n`.
+void sort_std_par(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["sort(n)"] = sort_n;
+
+  tbb::global_control limit(tbb::global_control::max_allowed_parallelism, state.range(0));
+
+  std::vector in = make_vec_sort();
+  std::vector out = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    out = in;
+    state.ResumeTiming();
+    std::sort(std::execution::par, out.begin(), out.end());
+  }
+
+  check_sort(out);
+}
+
+} // namespace
+
+BENCHMARK(sort_tbb)->Apply(targs)->UseRealTime();
+BENCHMARK(sort_std_par)->Apply(targs)->UseRealTime();
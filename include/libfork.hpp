@@ -12,12 +12,22 @@
 #include "libfork/core.hpp"
 #include "libfork/schedule.hpp"
 
+#include "libfork/algorithm/blocked_range.hpp"
 #include "libfork/algorithm/constraints.hpp"
+#include "libfork/algorithm/filter.hpp"
+#include "libfork/algorithm/find.hpp"
 #include "libfork/algorithm/fold.hpp"
 #include "libfork/algorithm/for_each.hpp"
+#include "libfork/algorithm/graph.hpp"
+#include "libfork/algorithm/lazy_split.hpp"
 #include "libfork/algorithm/lift.hpp"
 #include "libfork/algorithm/map.hpp"
+#include "libfork/algorithm/pipeline.hpp"
+#include "libfork/algorithm/radix_sort.hpp"
+#include "libfork/algorithm/reduce.hpp"
 #include "libfork/algorithm/scan.hpp"
+#include "libfork/algorithm/sort.hpp"
+#include "libfork/algorithm/transform_reduce.hpp"
 
 /**
  * @file libfork.hpp
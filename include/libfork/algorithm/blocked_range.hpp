@@ -0,0 +1,197 @@
+#ifndef B3D8F1A6_2C47_4E95_9A0B_6E1C7D4F8A23
+#define B3D8F1A6_2C47_4E95_9A0B_6E1C7D4F8A23
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>    // for array
+#include <concepts> // for integral
+#include <cstddef>  // for size_t, ptrdiff_t
+#include <ranges>   // for views::iota
+#include <utility>  // for pair
+
+#include "libfork/core/macro.hpp" // for LF_ASSERT
+
+/**
+ * @file blocked_range.hpp
+ *
+ * @brief A multidimensional index space for `lf::for_each` that is split into tiles.
+ */
+
+namespace lf {
+
+/**
+ * @brief An `N`-dimensional box of indices, `[begin(d), end(d))` in each dimension `d`, and their grains.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[for_each](lf::blocked_range<2>{{0, 0}, {rows, cols}, {64, 64}}, [&](auto tile) {
+ *      for (auto i : tile.indices(0)) {
+ *        for (auto j : tile.indices(1)) {
+ *          out[i * cols + j] = ...;
+ *        }
+ *      }
+ *    });
+ *
+ * \endrst
+ *
+ * A dimension is divisible while its extent is larger than its grain, ``lf::for_each`` halves the longest
+ * divisible dimension until none are left then, invokes the function with each tile. This recursive
+ * bisection of the longest side gives a cache-oblivious traversal: tiles that are close in the recursion are
+ * close in space, at every scale.
+ */
+template <std::size_t N, std::integral Int = std::ptrdiff_t>
+  requires (N > 0)
+class blocked_range {
+ public:
+  /**
+   * @brief The type of an index.
+   */
+  using index_type = Int;
+
+  /**
+   * @brief The indices `[begin, end)` with a grain of `grain` in every dimension.
+   */
+  constexpr blocked_range(std::array<Int, N> const &begin,
+                          std::array<Int, N> const &end,
+                          std::array<Int, N> const &grain) noexcept
+      : m_begin{begin},
+        m_end{end},
+        m_grain{grain} {
+    for (std::size_t d = 0; d < N; ++d) {
+      LF_ASSERT(m_begin[d] <= m_end[d]);
+      LF_ASSERT(m_grain[d] > 0);
+    }
+  }
+
+  /**
+   * @brief The indices `[begin, end)` with a grain of one in every dimension.
+   */
+  constexpr blocked_range(std::array<Int, N> const &begin, std::array<Int, N> const &end) noexcept
+      : blocked_range(begin, end, ones()) {}
+
+  /**
+   * @brief The number of dimensions.
+   */
+  [[nodiscard]] static constexpr auto rank() noexcept -> std::size_t { return N; }
+
+  /**
+   * @brief The first index in dimension `d`.
+   */
+  [[nodiscard]] constexpr auto begin(std::size_t d) const noexcept -> Int { return m_begin[d]; }
+
+  /**
+   * @brief One past the last index in dimension `d`.
+   */
+  [[nodiscard]] constexpr auto end(std::size_t d) const noexcept -> Int { return m_end[d]; }
+
+  /**
+   * @brief The grain of dimension `d`.
+   */
+  [[nodiscard]] constexpr auto grain(std::size_t d) const noexcept -> Int { return m_grain[d]; }
+
+  /**
+   * @brief The number of indices in dimension `d`.
+   */
+  [[nodiscard]] constexpr auto extent(std::size_t d) const noexcept -> Int { return m_end[d] - m_begin[d]; }
+
+  /**
+   * @brief A view of the indices in dimension `d`.
+   */
+  [[nodiscard]] constexpr auto indices(std::size_t d) const noexcept {
+    return std::views::iota(m_begin[d], m_end[d]);
+  }
+
+  /**
+   * @brief Test if the box contains no indices.
+   */
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool {
+    for (std::size_t d = 0; d < N; ++d) {
+      if (m_begin[d] == m_end[d]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Test if any dimension is larger than its grain.
+   */
+  [[nodiscard]] constexpr auto is_divisible() const noexcept -> bool { return split_dim() < N; }
+
+  /**
+   * @brief Halve the longest divisible dimension, requires `is_divisible()`.
+   */
+  [[nodiscard]] constexpr auto split() const noexcept -> std::pair<blocked_range, blocked_range> {
+
+    std::size_t d = split_dim();
+
+    LF_ASSERT(d < N);
+
+    std::pair<blocked_range, blocked_range> halves{*this, *this};
+
+    Int mid = m_begin[d] + extent(d) / 2;
+
+    halves.first.m_end[d] = mid;
+    halves.second.m_begin[d] = mid;
+
+    return halves;
+  }
+
+  /**
+   * @brief Compare the indices and grains.
+   */
+  constexpr auto operator==(blocked_range const &) const noexcept -> bool = default;
+
+ private:
+  static constexpr auto ones() noexcept -> std::array<Int, N> {
+    std::array<Int, N> out;
+    out.fill(1);
+    return out;
+  }
+
+  /**
+   * @brief Get the longest dimension larger than its grain or, `N` if there are none.
+   */
+  [[nodiscard]] constexpr auto split_dim() const noexcept -> std::size_t {
+
+    std::size_t best = N;
+
+    for (std::size_t d = 0; d < N; ++d) {
+      if (extent(d) > m_grain[d] && (best == N || extent(d) > extent(best))) {
+        best = d;
+      }
+    }
+
+    return best;
+  }
+
+  std::array<Int, N> m_begin;
+  std::array<Int, N> m_end;
+  std::array<Int, N> m_grain;
+};
+
+/**
+ * @brief A two dimensional `lf::blocked_range`.
+ */
+template <std::integral Int = std::ptrdiff_t>
+using blocked_range2d = blocked_range<2, Int>;
+
+/**
+ * @brief A three dimensional `lf::blocked_range`.
+ */
+template <std::integral Int = std::ptrdiff_t>
+using blocked_range3d = blocked_range<3, Int>;
+
+} // namespace lf
+
+#endif /* B3D8F1A6_2C47_4E95_9A0B_6E1C7D4F8A23 */
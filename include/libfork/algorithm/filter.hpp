@@ -0,0 +1,635 @@
+#ifndef E9C2A4D7_6F13_4B85_B3E0_1A7D5C8F2B64
+#define E9C2A4D7_6F13_4B85_B3E0_1A7D5C8F2B64
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, min, ranges::partition, ranges::swap_ranges, ranges::move
+#include <cstddef>     // for size_t, nullptr_t
+#include <functional>  // for identity, invoke
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, indirect_unary_predicate, ...
+#include <memory>      // for make_unique_for_overwrite
+#include <ranges>      // for begin, end, iterator_t, random_access_range, sized_range, views::iota
+#include <thread>      // for thread
+#include <type_traits> // for is_trivially_copyable_v, is_same_v, type_identity_t, ...
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "libfork/algorithm/for_each.hpp" // for for_each
+#include "libfork/core/control_flow.hpp"  // for call, fork, join
+#include "libfork/core/just.hpp"          // for just
+#include "libfork/core/macro.hpp"         // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"          // for task
+
+/**
+ * @file filter.hpp
+ *
+ * @brief Parallel stream compaction, implementations of `std::copy_if`, `std::remove_if` and friends.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief The input of a compaction and the per-chunk counts of the elements that match the predicate.
+ *
+ * The chunks (of `n` elements) form the leaves of an implicit binary tree, each internal node of which is
+ * identified by its split point `mid` (unique among the internal nodes).
+ */
+template <typename I, typename Pred, typename Proj>
+struct filter_state {
+
+  using diff_t = std::iter_difference_t<I>;
+
+  I src;
+  diff_t len;
+  diff_t n;
+  Pred pred;
+  Proj proj;
+  /**
+   * @brief Indexed by `mid`, the number of matches in chunks `[lo, mid)`.
+   */
+  std::vector<diff_t> left;
+
+  [[nodiscard]] auto chunks() const noexcept -> diff_t { return (len + n - 1) / n; }
+
+  [[nodiscard]] auto test(diff_t i) -> bool { return std::invoke(pred, std::invoke(proj, src[i])); }
+};
+
+/**
+ * @brief Up-sweep, count the matches in chunks `[lo, hi)` recording the counts of the left children.
+ */
+struct filter_count {
+  template <typename State, typename Diff = typename State::diff_t>
+  LF_STATIC_CALL auto
+  operator()(auto count, State *state, std::type_identity_t<Diff> lo, std::type_identity_t<Diff> hi)
+      LF_STATIC_CONST->lf::task<Diff> {
+
+    if (hi - lo == 1) {
+
+      Diff matches = 0;
+
+      for (Diff i = lo * state->n, end = std::min(state->len, i + state->n); i < end; ++i) {
+        if (state->test(i)) {
+          ++matches;
+        }
+      }
+
+      co_return matches;
+    }
+
+    Diff mid = lo + (hi - lo) / 2;
+
+    Diff l = 0;
+    Diff r = 0;
+
+    // clang-format off
+
+    co_await lf::fork(&l, count)(state, lo, mid);
+
+    LF_TRY {
+      co_await lf::call(&r, count)(state, mid, hi);
+    } LF_CATCH_ALL {
+      count.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+
+    state->left[static_cast<std::size_t>(mid)] = l;
+
+    co_return l + r;
+  }
+};
+
+/**
+ * @brief Down-sweep, write the matches of chunks `[lo, hi)` to `yes` and the others to `no`.
+ *
+ * Either output can be `nullptr` in which case those elements are skipped.
+ */
+template <bool Move>
+struct filter_scatter {
+  template <typename State, typename Yes, typename No, typename Diff = typename State::diff_t>
+  LF_STATIC_CALL auto operator()(auto scatter,
+                                 State *state,
+                                 std::type_identity_t<Diff> lo,
+                                 std::type_identity_t<Diff> hi,
+                                 Yes yes,
+                                 No no) LF_STATIC_CONST->lf::task<> {
+
+    constexpr bool keep_yes = !std::is_same_v<Yes, std::nullptr_t>;
+    constexpr bool keep_no = !std::is_same_v<No, std::nullptr_t>;
+
+    auto put = [state](auto &out, Diff i) {
+      if constexpr (Move) {
+        *out = std::ranges::iter_move(state->src + i);
+      } else {
+        *out = state->src[i];
+      }
+      ++out;
+    };
+
+    if (hi - lo == 1) {
+
+      for (Diff i = lo * state->n, end = std::min(state->len, i + state->n); i < end; ++i) {
+        if (state->test(i)) {
+          if constexpr (keep_yes) {
+            put(yes, i);
+          }
+        } else {
+          if constexpr (keep_no) {
+            put(no, i);
+          }
+        }
+      }
+
+      co_return;
+    }
+
+    Diff mid = lo + (hi - lo) / 2;
+
+    Diff l_yes = state->left[static_cast<std::size_t>(mid)];
+    Diff l_no = (mid - lo) * state->n - l_yes;
+
+    Yes r_yes = yes;
+    No r_no = no;
+
+    if constexpr (keep_yes) {
+      r_yes += l_yes;
+    }
+
+    if constexpr (keep_no) {
+      r_no += l_no;
+    }
+
+    // clang-format off
+
+    co_await lf::fork(scatter)(state, lo, mid, yes, no);
+
+    LF_TRY {
+      co_await lf::call(scatter)(state, mid, hi, r_yes, r_no);
+    } LF_CATCH_ALL {
+      scatter.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Move `[src, src + len)` to `dst` in chunks of `n`.
+ */
+struct filter_move_back {
+  template <typename Src, typename Dst, typename Diff>
+  LF_STATIC_CALL auto operator()(auto /* unused */, Src src, Dst dst, Diff len, Diff n)
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::just(lf::for_each)(std::views::iota(Diff{0}, (len + n - 1) / n), 1, [=](Diff c) {
+      std::ranges::move(src + c * n, src + std::min(len, c * n + n), dst + c * n);
+    });
+  }
+};
+
+/**
+ * @brief Copy the elements of `[head, tail)` that match to `out`, returns the end of the output.
+ */
+struct copy_if_impl {
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename O,
+            typename Pred,
+            typename Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, O out, std::iter_difference_t<I> n, Pred pred, Proj proj)
+      LF_STATIC_CONST->lf::task<O> {
+
+    LF_ASSERT(n > 0);
+
+    auto len = tail - head;
+
+    if (len == 0) {
+      co_return out;
+    }
+
+    filter_state<I, Pred, Proj> state{head, len, n, std::move(pred), std::move(proj), {}};
+
+    state.left.resize(static_cast<std::size_t>(state.chunks()));
+
+    auto matches = co_await lf::just(filter_count{})(&state, 0, state.chunks());
+
+    co_await lf::just(filter_scatter<false>{})(&state, 0, state.chunks(), out, nullptr);
+
+    co_return out + matches;
+  }
+};
+
+/**
+ * @brief Stable compaction via a buffer.
+ *
+ * If `Remove` the matches are discarded otherwise, they are moved to the front.
+ */
+template <bool Remove>
+struct buffered_filter_impl {
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename Pred, typename Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Pred pred, Proj proj)
+      LF_STATIC_CONST->lf::task<I> {
+
+    LF_ASSERT(n > 0);
+
+    using value_t = std::iter_value_t<I>;
+
+    auto len = tail - head;
+
+    if (len == 0) {
+      co_return head;
+    }
+
+    if constexpr (std::is_trivially_copyable_v<value_t> && //
+                  std::is_trivially_default_constructible_v<value_t>) {
+      // Scatter into an uninitialized buffer then, move the result back.
+      auto buf = std::make_unique_for_overwrite<value_t[]>(static_cast<std::size_t>(len));
+
+      filter_state<I, Pred, Proj> state{head, len, n, std::move(pred), std::move(proj), {}};
+
+      state.left.resize(static_cast<std::size_t>(state.chunks()));
+
+      auto matches = co_await lf::just(filter_count{})(&state, 0, state.chunks());
+
+      if constexpr (Remove) {
+        co_await lf::just(filter_scatter<true>{})(&state, 0, state.chunks(), nullptr, buf.get());
+        co_await lf::just(filter_move_back{})(buf.get(), head, len - matches, n);
+        co_return head + (len - matches);
+      } else {
+        co_await lf::just(filter_scatter<true>{})(&state, 0, state.chunks(), buf.get(), buf.get() + matches);
+        co_await lf::just(filter_move_back{})(buf.get(), head, len, n);
+        co_return head + matches;
+      }
+    } else {
+      // Move the input into the buffer and scatter it back, avoids tracking uninitialized elements.
+      using buf_t = std::vector<value_t>;
+
+      buf_t buf(std::make_move_iterator(head), std::make_move_iterator(head + len));
+
+      filter_state<typename buf_t::iterator, Pred, Proj> state{
+          buf.begin(), len, n, std::move(pred), std::move(proj), {},
+      };
+
+      state.left.resize(static_cast<std::size_t>(state.chunks()));
+
+      auto matches = co_await lf::just(filter_count{})(&state, 0, state.chunks());
+
+      if constexpr (Remove) {
+        co_await lf::just(filter_scatter<true>{})(&state, 0, state.chunks(), nullptr, head);
+        co_return head + (len - matches);
+      } else {
+        co_await lf::just(filter_scatter<true>{})(&state, 0, state.chunks(), head, head + matches);
+        co_return head + matches;
+      }
+    }
+  }
+};
+
+/**
+ * @brief Swap `[a, a + len)` with `[b, b + len)`.
+ */
+struct swap_ranges_impl {
+  template <typename I>
+  LF_STATIC_CALL auto
+  operator()(auto swap, I a, I b, std::iter_difference_t<I> len, std::iter_difference_t<I> n)
+      LF_STATIC_CONST->lf::task<> {
+
+    if (len <= n) {
+      std::ranges::swap_ranges(a, a + len, b, b + len);
+      co_return;
+    }
+
+    auto half = len / 2;
+
+    // clang-format off
+
+    co_await lf::fork(swap)(a, b, half, n);
+
+    LF_TRY {
+      co_await lf::call(swap)(a + half, b + half, len - half, n);
+    } LF_CATCH_ALL {
+      swap.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief In-place partition, partition both halves then swap the misplaced blocks in the middle.
+ */
+struct partition_impl {
+  /**
+   * @brief Recursive version, returns the partition point.
+   */
+  template <std::random_access_iterator I, typename Pred, typename Proj>
+  LF_STATIC_CALL auto
+  operator()(auto part, I head, I tail, std::iter_difference_t<I> n, Pred pred, Proj proj)
+      LF_STATIC_CONST->lf::task<I> {
+
+    auto len = tail - head;
+
+    if (len <= n) {
+      co_return std::ranges::begin(std::ranges::partition(head, tail, pred, proj));
+    }
+
+    I mid = head + len / 2;
+
+    I l_mid;
+    I r_mid;
+
+    // clang-format off
+
+    co_await lf::fork(&l_mid, part)(head, mid, n, pred, proj);
+
+    LF_TRY {
+      co_await lf::call(&r_mid, part)(mid, tail, n, pred, proj);
+    } LF_CATCH_ALL {
+      part.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+
+    // [head, l_mid) yes, [l_mid, mid) no, [mid, r_mid) yes, [r_mid, tail) no.
+    auto swaps = std::min(mid - l_mid, r_mid - mid);
+
+    co_await lf::just(swap_ranges_impl{})(l_mid, r_mid - swaps, swaps, n);
+
+    co_return l_mid + (r_mid - mid);
+  }
+
+  /**
+   * @brief Entry point for a sentinel.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename Pred, typename Proj>
+    requires (!std::same_as<I, S>)
+  LF_STATIC_CALL auto
+  operator()(auto part, I head, S tail, std::iter_difference_t<I> n, Pred pred, Proj proj)
+      LF_STATIC_CONST->lf::task<I> {
+    co_return co_await lf::just(part)(head, head + (tail - head), n, std::move(pred), std::move(proj));
+  }
+};
+
+/**
+ * @brief The chunk size used when none is given.
+ */
+template <typename Int>
+auto default_filter_grain(Int len) noexcept -> Int {
+  auto const workers = static_cast<Int>(std::max(std::thread::hardware_concurrency(), 1U));
+  return std::max(len / (8 * workers), Int{1} << 12);
+}
+
+/**
+ * @brief Overload set for `lf::copy_if`.
+ */
+struct copy_if_overload {
+  /**
+   * @brief Copy from `[head, tail)` in chunks of `n`.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+    requires std::indirectly_copyable<I, O>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, O out, std::iter_difference_t<I> n, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<O> {
+    co_return co_await lf::just(copy_if_impl{})(head, tail, out, n, std::move(pred), std::move(proj));
+  }
+
+  /**
+   * @brief Copy from `[head, tail)` with a default chunk size.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+    requires std::indirectly_copyable<I, O>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, O out, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<O> {
+    auto n = default_filter_grain(tail - head);
+    co_return co_await lf::just(copy_if_impl{})(head, tail, out, n, std::move(pred), std::move(proj));
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range> && std::indirectly_copyable<std::ranges::iterator_t<Range>, O>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 Range &&range,
+                                 O out,
+                                 std::ranges::range_difference_t<Range> n,
+                                 Pred pred,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+    co_return co_await lf::just(copy_if_impl{})(
+        std::ranges::begin(range), std::ranges::end(range), out, n, std::move(pred), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range> && std::indirectly_copyable<std::ranges::iterator_t<Range>, O>
+  LF_STATIC_CALL auto operator()(auto /* unused */, Range &&range, O out, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<O> {
+    auto n = default_filter_grain(std::ranges::distance(range));
+    co_return co_await lf::just(copy_if_impl{})(
+        std::ranges::begin(range), std::ranges::end(range), out, n, std::move(pred), std::move(proj) //
+    );
+  }
+};
+
+/**
+ * @brief Overload set for the in-place algorithms, `Impl` does the work.
+ */
+template <typename Impl>
+struct permute_if_overload {
+  /**
+   * @brief Permute `[head, tail)` in chunks of `n`.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+    requires std::permutable<I>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<I> {
+    co_return co_await lf::just(Impl{})(head, tail, n, std::move(pred), std::move(proj));
+  }
+
+  /**
+   * @brief Permute `[head, tail)` with a default chunk size.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+    requires std::permutable<I>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<I> {
+    auto n = default_filter_grain(tail - head);
+    co_return co_await lf::just(Impl{})(head, tail, n, std::move(pred), std::move(proj));
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range> && std::permutable<std::ranges::iterator_t<Range>>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 Range &&range,
+                                 std::ranges::range_difference_t<Range> n,
+                                 Pred pred,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<std::ranges::iterator_t<Range>> {
+    co_return co_await lf::just(Impl{})(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(pred), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range> && std::permutable<std::ranges::iterator_t<Range>>
+  LF_STATIC_CALL auto operator()(auto /* unused */, Range &&range, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::ranges::iterator_t<Range>> {
+    auto n = default_filter_grain(std::ranges::distance(range));
+    co_return co_await lf::just(Impl{})(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(pred), std::move(proj) //
+    );
+  }
+};
+
+} // namespace detail
+
+} // namespace impl
+
+// clang-format off
+
+/**
+ * @brief A parallel implementation of `std::ranges::copy_if`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              std::random_access_iterator O,
+ *              typename Proj = std::identity,
+ *              std::indirect_unary_predicate<std::projected<I, Proj>> Pred
+ *              >
+ *      requires std::indirectly_copyable<I, O>
+ *    auto copy_if(I head, S tail, O out, std::iter_difference_t<I> n, Pred pred, Proj proj = {}) -> O;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will choose a chunk size based on the length of the input and the hardware concurrency).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::vector<int> out(v.size());
+ *
+ *    auto end = co_await just[copy_if](v, out.begin(), [](int x) { return x % 2 == 0; });
+ *
+ *    out.erase(end, out.end());
+ *
+ * \endrst
+ *
+ * The relative order of the copied elements is preserved and the end of the output is returned. The input
+ * is traversed twice, an up-sweep counts the matches in each chunk (of ``n`` elements) and a down-sweep
+ * copies them to their offsets hence, ``pred`` is invoked twice per element and must be a pure function.
+ *
+ * This function will make an implementation defined number of copies of the function objects and may
+ * invoke these copies concurrently.
+ */
+inline constexpr impl::detail::copy_if_overload copy_if = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::remove_if`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              typename Proj = std::identity,
+ *              std::indirect_unary_predicate<std::projected<I, Proj>> Pred
+ *              >
+ *      requires std::permutable<I>
+ *    auto remove_if(I head, S tail, std::iter_difference_t<I> n, Pred pred, Proj proj = {}) -> I;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will choose a chunk size based on the length of the input and the hardware concurrency).
+ *
+ * \endrst
+ *
+ * The same two-pass count/scatter as ``lf::copy_if`` but, as the chunks cannot be compacted in-place
+ * concurrently, the kept elements are moved to a buffer and back. Returns the new end of the range, the
+ * elements after it are valid but unspecified.
+ */
+inline constexpr impl::detail::permute_if_overload<impl::detail::buffered_filter_impl<true>> remove_if = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::stable_partition`.
+ *
+ * Effective call signature is the same as ``lf::remove_if``, returns the partition point. The elements that
+ * satisfy ``pred`` are scattered to the front of a buffer and the others to the back then, moved back.
+ */
+inline constexpr impl::detail::permute_if_overload<impl::detail::buffered_filter_impl<false>>
+    stable_partition = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::partition`.
+ *
+ * Effective call signature is the same as ``lf::remove_if``, returns the partition point. This does not
+ * allocate, both halves are partitioned recursively (serially below ``n`` elements) and then the misplaced
+ * blocks either side of the middle are swapped in parallel. The relative order of elements is not preserved.
+ */
+inline constexpr impl::detail::permute_if_overload<impl::detail::partition_impl> partition = {};
+
+// clang-format on
+
+} // namespace lf
+
+#endif /* E9C2A4D7_6F13_4B85_B3E0_1A7D5C8F2B64 */
@@ -0,0 +1,584 @@
+#ifndef C1523763_2A8C_4168_A7E6_33C91B27A65C
+#define C1523763_2A8C_4168_A7E6_33C91B27A65C
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, min, ranges::mismatch_result
+#include <atomic>      // for atomic, memory_order_relaxed
+#include <functional>  // for identity, invoke, ranges::equal_to
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, indirect_unary_predicate, ...
+#include <ranges>      // for begin, end, distance, iterator_t, random_access_range, sized_range
+#include <thread>      // for thread
+#include <type_traits> // for common_type_t, type_identity_t
+#include <utility>     // for move
+
+#include "libfork/core/control_flow.hpp" // for call, fork, join
+#include "libfork/core/just.hpp"         // for just
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"         // for task
+
+/**
+ * @file find.hpp
+ *
+ * @brief Parallel searches with early exit, implementations of `std::find_if`, `std::any_of` and friends.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief Tests `pred(proj(head[i])) != Negate`.
+ */
+template <typename I, typename Pred, typename Proj, bool Negate>
+struct find_probe {
+
+  using diff_t = std::iter_difference_t<I>;
+
+  I head;
+  Pred pred;
+  Proj proj;
+
+  [[nodiscard]] auto operator()(diff_t i) -> bool {
+    return static_cast<bool>(std::invoke(pred, std::invoke(proj, head[i]))) != Negate;
+  }
+};
+
+/**
+ * @brief Tests if `head1[i]` and `head2[i]` differ.
+ */
+template <typename I1, typename I2, typename Pred, typename Proj1, typename Proj2>
+struct mismatch_probe {
+
+  using diff_t = std::common_type_t<std::iter_difference_t<I1>, std::iter_difference_t<I2>>;
+
+  I1 head1;
+  I2 head2;
+  Pred pred;
+  Proj1 proj1;
+  Proj2 proj2;
+
+  [[nodiscard]] auto operator()(diff_t i) -> bool {
+    return !static_cast<bool>(std::invoke(pred, std::invoke(proj1, head1[i]), std::invoke(proj2, head2[i])));
+  }
+};
+
+/**
+ * @brief The state shared by every task of a search.
+ *
+ * The index of the first match found so far is kept in `best`, it only ever decreases. Any chunk that
+ * starts at or after `best` cannot contain the first match, hence it can be skipped. The probe is not
+ * shared, each task holds its own copy.
+ */
+template <typename Probe>
+struct find_state {
+
+  using diff_t = typename Probe::diff_t;
+
+  /**
+   * @brief The number of elements tested between reloads of `best` in a leaf.
+   */
+  static constexpr diff_t k_block = 64;
+
+  diff_t n;
+  std::atomic<diff_t> best;
+
+  /**
+   * @brief True if no element in `[lo, ...)` could be the first match.
+   */
+  [[nodiscard]] auto skip(diff_t lo) const noexcept -> bool {
+    return best.load(std::memory_order_relaxed) <= lo;
+  }
+
+  /**
+   * @brief Lower `best` to `i`, unless a match before `i` has already been found.
+   */
+  void found(diff_t i) noexcept {
+    diff_t prev = best.load(std::memory_order_relaxed);
+    while (i < prev && !best.compare_exchange_weak(prev, i, std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * @brief Serially search `[lo, hi)` with `probe`, giving up once a match before the current block is known.
+   */
+  void leaf(Probe &probe, diff_t lo, diff_t hi) {
+    for (diff_t i = lo; i < hi; i += k_block) {
+
+      if (skip(i)) {
+        return;
+      }
+
+      for (diff_t j = i, end = std::min(hi, i + k_block); j < end; ++j) {
+        if (probe(j)) {
+          found(j);
+          return;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * @brief Search `[lo, hi)` recursively, splitting until there are at most `n` elements.
+ */
+struct find_impl {
+  template <typename Probe, typename Diff = typename Probe::diff_t>
+  LF_STATIC_CALL auto operator()(auto find,
+                                 find_state<Probe> *state,
+                                 Probe probe,
+                                 std::type_identity_t<Diff> lo,
+                                 std::type_identity_t<Diff> hi) LF_STATIC_CONST->lf::task<> {
+
+    if (state->skip(lo)) {
+      co_return;
+    }
+
+    if (hi - lo <= state->n) {
+      state->leaf(probe, lo, hi);
+      co_return;
+    }
+
+    Diff mid = lo + (hi - lo) / 2;
+
+    // clang-format off
+
+    co_await lf::fork(find)(state, probe, lo, mid);
+
+    LF_TRY {
+      co_await lf::call(find)(state, probe, mid, hi);
+    } LF_CATCH_ALL {
+      find.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Find the smallest `i` in `[0, len)` such that `probe(i)` is true, or `len` if there is none.
+ */
+struct find_root {
+  template <typename Probe, typename Diff = typename Probe::diff_t>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, Probe probe, std::type_identity_t<Diff> len, std::type_identity_t<Diff> n)
+      LF_STATIC_CONST->lf::task<Diff> {
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(len >= 0);
+
+    if (len == 0) {
+      co_return 0;
+    }
+
+    find_state<Probe> state{n, len};
+
+    co_await lf::just(find_impl{})(&state, std::move(probe), 0, len);
+
+    co_return state.best.load(std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief The chunk size used when none is given.
+ */
+template <typename Int>
+auto default_find_grain(Int len) noexcept -> Int {
+  auto const workers = static_cast<Int>(std::max(std::thread::hardware_concurrency(), 1U));
+  return std::max(len / (8 * workers), Int{1} << 10);
+}
+
+/**
+ * @brief Overload set for `lf::find_if`.
+ */
+struct find_if_overload {
+  /**
+   * @brief Search `[head, tail)` in chunks of `n`.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<I> {
+    using probe = find_probe<I, Pred, Proj, false>;
+
+    auto idx = co_await lf::just(find_root{})(probe{head, std::move(pred), std::move(proj)}, tail - head, n);
+
+    co_return head + idx;
+  }
+
+  /**
+   * @brief Search `[head, tail)` with a default chunk size.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+  LF_STATIC_CALL auto operator()(auto find_if, I head, S tail, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<I> {
+    co_return co_await lf::just(find_if)(head, tail, default_find_grain(tail - head), pred, proj);
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range>
+  LF_STATIC_CALL auto operator()(auto find_if,
+                                 Range &&range,
+                                 std::ranges::range_difference_t<Range> n,
+                                 Pred pred,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<std::ranges::iterator_t<Range>> {
+    co_return co_await lf::just(find_if)(std::ranges::begin(range), std::ranges::end(range), n, pred, proj);
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range>
+  LF_STATIC_CALL auto operator()(auto find_if, Range &&range, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::ranges::iterator_t<Range>> {
+    co_return co_await lf::just(find_if)(std::ranges::begin(range), std::ranges::end(range), pred, proj);
+  }
+};
+
+/**
+ * @brief The flavours of `quantify_overload`.
+ */
+enum class quantifier {
+  any,
+  all,
+  none,
+};
+
+/**
+ * @brief Overload set for `lf::any_of`, `lf::all_of` and `lf::none_of`.
+ *
+ * All three search for a witness, `all_of` searches for an element that does not satisfy the predicate.
+ */
+template <quantifier Q>
+struct quantify_overload {
+  /**
+   * @brief Search `[head, tail)` in chunks of `n`.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<bool> {
+
+    using probe = find_probe<I, Pred, Proj, Q == quantifier::all>;
+
+    auto len = tail - head;
+    auto idx = co_await lf::just(find_root{})(probe{head, std::move(pred), std::move(proj)}, len, n);
+
+    co_return (idx == len) == (Q != quantifier::any);
+  }
+
+  /**
+   * @brief Search `[head, tail)` with a default chunk size.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<I, Proj>> Pred>
+  LF_STATIC_CALL auto operator()(auto quantify, I head, S tail, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<bool> {
+    co_return co_await lf::just(quantify)(head, tail, default_find_grain(tail - head), pred, proj);
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range>
+  LF_STATIC_CALL auto operator()(auto quantify,
+                                 Range &&range,
+                                 std::ranges::range_difference_t<Range> n,
+                                 Pred pred,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<bool> {
+    co_return co_await lf::just(quantify)(std::ranges::begin(range), std::ranges::end(range), n, pred, proj);
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Proj = std::identity,
+            std::indirect_unary_predicate<std::projected<std::ranges::iterator_t<Range>, Proj>> Pred>
+    requires std::ranges::sized_range<Range>
+  LF_STATIC_CALL auto operator()(auto quantify, Range &&range, Pred pred, Proj proj = {})
+      LF_STATIC_CONST->lf::task<bool> {
+    co_return co_await lf::just(quantify)(std::ranges::begin(range), std::ranges::end(range), pred, proj);
+  }
+};
+
+/**
+ * @brief Overload set for `lf::mismatch` and, if `Equal` then `lf::equal`.
+ */
+template <bool Equal>
+struct mismatch_overload {
+
+  template <typename I1, typename I2>
+  using result_t = std::conditional_t<Equal, bool, std::ranges::mismatch_result<I1, I2>>;
+
+  /**
+   * @brief Compare `[head1, tail1)` and `[head2, tail2)` in chunks of `n`.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            std::sized_sentinel_for<I2> S2,
+            class Pred = std::ranges::equal_to,
+            class Proj1 = std::identity,
+            class Proj2 = std::identity>
+    requires std::indirectly_comparable<I1, I2, Pred, Proj1, Proj2>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I1 head1,
+                                 S1 tail1,
+                                 I2 head2,
+                                 S2 tail2,
+                                 std::iter_difference_t<I1> n,
+                                 Pred pred = {},
+                                 Proj1 proj1 = {},
+                                 Proj2 proj2 = {}) LF_STATIC_CONST->lf::task<result_t<I1, I2>> {
+
+    using probe = mismatch_probe<I1, I2, Pred, Proj1, Proj2>;
+    using diff_t = typename probe::diff_t;
+
+    diff_t len1 = tail1 - head1;
+    diff_t len2 = tail2 - head2;
+
+    if constexpr (Equal) {
+      if (len1 != len2) {
+        co_return false;
+      }
+    }
+
+    diff_t len = std::min(len1, len2);
+
+    diff_t idx = co_await lf::just(find_root{})(
+        probe{head1, head2, std::move(pred), std::move(proj1), std::move(proj2)}, len, n //
+    );
+
+    if constexpr (Equal) {
+      co_return idx == len;
+    } else {
+      co_return {head1 + idx, head2 + idx};
+    }
+  }
+
+  /**
+   * @brief Compare `[head1, tail1)` and `[head2, tail2)` with a default chunk size.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            std::sized_sentinel_for<I2> S2,
+            class Pred = std::ranges::equal_to,
+            class Proj1 = std::identity,
+            class Proj2 = std::identity>
+    requires std::indirectly_comparable<I1, I2, Pred, Proj1, Proj2>
+  LF_STATIC_CALL auto operator()(auto mismatch,
+                                 I1 head1,
+                                 S1 tail1,
+                                 I2 head2,
+                                 S2 tail2,
+                                 Pred pred = {},
+                                 Proj1 proj1 = {},
+                                 Proj2 proj2 = {}) LF_STATIC_CONST->lf::task<result_t<I1, I2>> {
+
+    auto n = default_find_grain(std::min<std::iter_difference_t<I1>>(tail1 - head1, tail2 - head2));
+
+    co_return co_await lf::just(mismatch)(head1, tail1, head2, tail2, n, pred, proj1, proj2);
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R1,
+            std::ranges::random_access_range R2,
+            class Pred = std::ranges::equal_to,
+            class Proj1 = std::identity,
+            class Proj2 = std::identity>
+    requires std::ranges::sized_range<R1> && std::ranges::sized_range<R2> &&
+             std::indirectly_comparable<std::ranges::iterator_t<R1>,
+                                        std::ranges::iterator_t<R2>,
+                                        Pred,
+                                        Proj1,
+                                        Proj2>
+  LF_STATIC_CALL auto operator()(auto mismatch,
+                                 R1 &&range1,
+                                 R2 &&range2,
+                                 std::ranges::range_difference_t<R1> n,
+                                 Pred pred = {},
+                                 Proj1 proj1 = {},
+                                 Proj2 proj2 = {}) LF_STATIC_CONST
+      ->lf::task<result_t<std::ranges::iterator_t<R1>, std::ranges::iterator_t<R2>>> {
+    co_return co_await lf::just(mismatch)(std::ranges::begin(range1),
+                                          std::ranges::end(range1),
+                                          std::ranges::begin(range2),
+                                          std::ranges::end(range2),
+                                          n,
+                                          pred,
+                                          proj1,
+                                          proj2);
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R1,
+            std::ranges::random_access_range R2,
+            class Pred = std::ranges::equal_to,
+            class Proj1 = std::identity,
+            class Proj2 = std::identity>
+    requires std::ranges::sized_range<R1> && std::ranges::sized_range<R2> &&
+             std::indirectly_comparable<std::ranges::iterator_t<R1>,
+                                        std::ranges::iterator_t<R2>,
+                                        Pred,
+                                        Proj1,
+                                        Proj2>
+  LF_STATIC_CALL auto
+  operator()(auto mismatch, R1 &&range1, R2 &&range2, Pred pred = {}, Proj1 proj1 = {}, Proj2 proj2 = {})
+      LF_STATIC_CONST->lf::task<result_t<std::ranges::iterator_t<R1>, std::ranges::iterator_t<R2>>> {
+    co_return co_await lf::just(mismatch)(std::ranges::begin(range1),
+                                          std::ranges::end(range1),
+                                          std::ranges::begin(range2),
+                                          std::ranges::end(range2),
+                                          pred,
+                                          proj1,
+                                          proj2);
+  }
+};
+
+} // namespace detail
+
+} // namespace impl
+
+// clang-format off
+
+/**
+ * @brief A parallel implementation of `std::ranges::find_if`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              typename Proj = std::identity,
+ *              std::indirect_unary_predicate<std::projected<I, Proj>> Pred
+ *              >
+ *    auto find_if(I head, S tail, std::iter_difference_t<I> n, Pred pred, Proj proj = {}) -> I;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will choose a chunk size based on the length of the input and the hardware concurrency).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    auto it = co_await just[find_if](v, 1024, [](int x) { return x < 0; });
+ *
+ * \endrst
+ *
+ * Returns an iterator to the first element that satisfies ``pred``, or ``tail`` if there is none. The
+ * search is split into chunks of ``n`` elements and all tasks share the index of the first match found so
+ * far, any fork (or block of a chunk) that starts after it returns immediately. The result is the same as
+ * a serial search, unlike ``std::find_if`` elements after the first match may be tested.
+ *
+ * This function will make an implementation defined number of copies of the function objects and may
+ * invoke these copies concurrently. The predicate must be a regular (not async) function.
+ */
+inline constexpr impl::detail::find_if_overload find_if = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::any_of`.
+ *
+ * Effective call signature is the same as ``lf::find_if``, returns true if any element satisfies ``pred``.
+ * The search stops (up to the chunk size) as soon as one is found.
+ */
+inline constexpr impl::detail::quantify_overload<impl::detail::quantifier::any> any_of = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::all_of`.
+ *
+ * Effective call signature is the same as ``lf::find_if``, returns true if every element satisfies ``pred``.
+ * The search stops (up to the chunk size) as soon as a counterexample is found.
+ */
+inline constexpr impl::detail::quantify_overload<impl::detail::quantifier::all> all_of = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::none_of`.
+ *
+ * Effective call signature is the same as ``lf::find_if``, returns true if no element satisfies ``pred``.
+ */
+inline constexpr impl::detail::quantify_overload<impl::detail::quantifier::none> none_of = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::mismatch`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I1,
+ *              std::sized_sentinel_for<I1> S1,
+ *              std::random_access_iterator I2,
+ *              std::sized_sentinel_for<I2> S2,
+ *              class Pred = std::ranges::equal_to,
+ *              class Proj1 = std::identity,
+ *              class Proj2 = std::identity
+ *              >
+ *      requires std::indirectly_comparable<I1, I2, Pred, Proj1, Proj2>
+ *    auto mismatch(I1 head1, S1 tail1, I2 head2, S2 tail2, std::iter_difference_t<I1> n, Pred pred = {}, Proj1 proj1 = {}, Proj2 proj2 = {})
+ *        -> std::ranges::mismatch_result<I1, I2>;
+ *
+ * Overloads exist for random-access ranges (instead of the iterator pairs) and ``n`` can be omitted.
+ *
+ * \endrst
+ *
+ * Returns iterators to the first pair of elements that do not satisfy ``pred``, the search shares the same
+ * early exit as ``lf::find_if``.
+ */
+inline constexpr impl::detail::mismatch_overload<false> mismatch = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::equal`.
+ *
+ * Effective call signature is the same as ``lf::mismatch``, returns true if the inputs have the same length
+ * and every pair of elements satisfies ``pred``.
+ */
+inline constexpr impl::detail::mismatch_overload<true> equal = {};
+
+// clang-format on
+
+} // namespace lf
+
+#endif /* C1523763_2A8C_4168_A7E6_33C91B27A65C */
@@ -9,6 +9,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>   // for min
 #include <concepts>    // for invocable
 #include <functional>  // for identity, invoke
 #include <iterator>    // for random_access_iterator, sized_sentinel_for
@@ -17,6 +18,8 @@
 #include <type_traits> // for decay_t
 
 #include "libfork/algorithm/constraints.hpp" // for projected, indirect_fold_acc_t, indirectly_...
+#include "libfork/algorithm/lazy_split.hpp"  // for lazy_split_t, work_wanted
+#include "libfork/algorithm/leaf.hpp"        // for fold_lanes, lane_foldable
 #include "libfork/core/control_flow.hpp"     // for call, fork, join, dispatch
 #include "libfork/core/eventually.hpp"       // for eventually
 #include "libfork/core/just.hpp"             // for just
@@ -47,6 +50,8 @@ struct fold_overload_impl {
 
   static constexpr bool async_bop = !std::invocable<Bop &, acc_t, std::iter_reference_t<projected<I, Proj>>>;
 
+  static constexpr bool sync_leaf = !async_bop && std::invocable<Proj &, std::iter_reference_t<I>>;
+
   /**
    * @brief Recursive implementation of `fold`, requires that `tail - head > 0`.
    */
@@ -61,6 +66,10 @@ struct fold_overload_impl {
 
     if (len <= n) {
 
+      if constexpr (sync_leaf) {
+        co_return fold_chunk(acc_t(std::invoke(proj, *head)), head + 1, head + len, bop, proj);
+      }
+
       acc_t lhs = acc_t(co_await just(proj)(*head)); // Require convertible to U
 
       using mod = modifier::eager_throw_outside;
@@ -104,6 +113,84 @@ struct fold_overload_impl {
     );                                       //
   }
 
+  /**
+   * @brief Fold `[head, stop)` into `acc`, outside of the coroutine frame so `acc` can live in a register.
+   *
+   * Well-known operators over arithmetic types are dispatched to a multi-accumulator kernel.
+   */
+  static auto fold_chunk(acc_t acc, I head, I stop, Bop &bop, Proj &proj) -> acc_t {
+    if constexpr (detail::lane_foldable<I, Bop, Proj, acc_t>) {
+      return detail::fold_lanes(std::move(acc), head, stop, bop);
+    } else {
+      for (; head != stop; ++head) {
+        acc = std::invoke(bop, std::move(acc), std::invoke(proj, *head));
+      }
+      return acc;
+    }
+  }
+
+  /**
+   * @brief Lazy binary splitting implementation of `fold`, requires that `tail - head > 0`.
+   */
+  LF_STATIC_CALL auto operator()(auto fold, I head, S tail, lazy_split_t lazy, Bop bop, Proj proj)
+      LF_STATIC_CONST->lf::task<acc_t> {
+
+    LF_ASSERT(lazy.chunk > 0);
+    LF_ASSERT(tail - head > 0);
+
+    acc_t acc = acc_t(co_await just(proj)(*head)); // Require convertible to U
+
+    using mod = modifier::eager_throw_outside;
+
+    for (++head; head != tail;) {
+
+      int_t len = tail - head;
+
+      if (len > lazy.chunk && detail::work_wanted()) {
+
+        auto mid = head + (len / 2);
+
+        eventually<acc_t> lhs;
+        eventually<acc_t> rhs;
+
+        // clang-format off
+
+        co_await lf::fork(&lhs, fold)(head, mid, lazy, bop, proj);
+
+        LF_TRY {
+          co_await lf::call(&rhs, fold)(mid, tail, lazy, bop, proj);
+        } LF_CATCH_ALL {
+          fold.stash_exception();
+        }
+
+        // clang-format on
+
+        co_await lf::join;
+
+        acc = co_await just(bop)(std::move(acc), *std::move(lhs));
+
+        co_return co_await just(std::move(bop))(std::move(acc), *std::move(rhs));
+      }
+
+      auto stop = head + std::min(len, int_t(lazy.chunk));
+
+      if constexpr (sync_leaf) {
+        acc = fold_chunk(std::move(acc), head, stop, bop, proj);
+        head = stop;
+      } else {
+        for (; head != stop; ++head) {
+          if constexpr (async_bop) {
+            co_await lf::dispatch<tag::call, mod>(&acc, bop)(std::move(acc), co_await just(proj)(*head));
+          } else {
+            acc = std::invoke(bop, std::move(acc), co_await just(proj)(*head));
+          }
+        }
+      }
+    }
+
+    co_return std::move(acc);
+  }
+
   /**
    * @brief Recursive implementation of `fold` for `n = 1`, requires that `tail - head > 1`.
    *
@@ -206,6 +293,26 @@ struct fold_overload {
     );
   }
 
+  /**
+   * @brief Lazy binary splitting version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            indirectly_foldable<projected<I, Proj>> Bop>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, lazy_split_t lazy, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::optional<indirect_fold_acc_t<Bop, I, Proj>>> {
+
+    if (head == tail) {
+      co_return std::nullopt;
+    }
+
+    co_return co_await lf::just(detail::fold_overload_impl<I, S, Proj, Bop>{})(
+        std::move(head), std::move(tail), lazy, std::move(bop), std::move(proj) //
+    );
+  }
+
   /**
    * @brief Range version.
    */
@@ -259,6 +366,29 @@ struct fold_overload {
         std::ranges::begin(range), std::ranges::end(range), n, std::move(bop), std::move(proj) //
     );
   }
+
+  /**
+   * @brief Range lazy binary splitting version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Proj = std::identity,
+            indirectly_foldable<projected<std::ranges::iterator_t<Range>, Proj>> Bop>
+    requires std::ranges::sized_range<Range>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, Range &&range, lazy_split_t lazy, Bop bop, Proj proj = {}) LF_STATIC_CONST
+      ->lf::task<std::optional<indirect_fold_acc_t<Bop, std::ranges::iterator_t<Range>, Proj>>> {
+
+    if (std::ranges::empty(range)) {
+      co_return std::nullopt;
+    }
+
+    using I = std::decay_t<decltype(std::ranges::begin(range))>;
+    using S = std::decay_t<decltype(std::ranges::end(range))>;
+
+    co_return co_await lf::just(detail::fold_overload_impl<I, S, Proj, Bop>{})(
+        std::ranges::begin(range), std::ranges::end(range), lazy, std::move(bop), std::move(proj) //
+    );
+  }
 };
 
 } // namespace impl
@@ -282,7 +412,7 @@ struct fold_overload {
  *    auto fold(I head, S tail, std::iter_difference_t<I> n, Bop bop, Proj proj = {}) -> indirect_fold_acc_t<Bop, I, Proj>;
  *
  * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
- * (which will set ``n = 1``).
+ * (which will set ``n = 1``) or, replaced by ``lf::lazy_split`` to choose the chunks at runtime.
  *
  * Exemplary usage:
  *
@@ -301,6 +431,11 @@ struct fold_overload {
  *
  * Unlike the `std::ranges::fold` variations, this function will make an implementation defined number of copies
  * of the function objects and may invoke these copies concurrently.
+ *
+ * When folding arithmetic values with ``std::plus`` or ``std::multiplies`` (or integral values with
+ * ``std::ranges::min`` or ``std::ranges::max``) and no projection, each chunk is folded with several
+ * independent accumulators so that the compiler can vectorize it. This re-associates floating point sums (as
+ * the parallel split already does).
  */
 inline constexpr impl::fold_overload fold = {};
 
@@ -9,15 +9,20 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>  // for min
+#include <concepts>   // for integral
+#include <cstddef>    // for size_t
 #include <functional> // for identity
 #include <iterator>   // for iter_difference_t, random_access_iterator
 #include <ranges>     // for begin, end, iterator_t, random_access_range
 
-#include "libfork/algorithm/constraints.hpp" // for indirectly_unary_invocable, projected
-#include "libfork/core/control_flow.hpp"     // for call, fork, join
-#include "libfork/core/just.hpp"             // for just
-#include "libfork/core/macro.hpp"            // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
-#include "libfork/core/task.hpp"             // for task
+#include "libfork/algorithm/blocked_range.hpp" // for blocked_range
+#include "libfork/algorithm/constraints.hpp"   // for indirectly_unary_invocable, projected, invocable
+#include "libfork/algorithm/lazy_split.hpp"    // for lazy_split_t, work_wanted
+#include "libfork/core/control_flow.hpp"       // for call, fork, join
+#include "libfork/core/just.hpp"               // for just
+#include "libfork/core/macro.hpp"              // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"               // for task
 
 /**
  * @file for_each.hpp
@@ -118,6 +123,48 @@ struct for_each_overload {
     }
   }
 
+  /**
+   * @brief Lazy binary splitting version, only splits when another worker is idle.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename Proj = std::identity,
+            indirectly_unary_invocable<projected<I, Proj>> Fun>
+  LF_STATIC_CALL auto operator()(auto for_each, I head, S tail, lazy_split_t lazy, Fun fun, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(lazy.chunk > 0);
+
+    for (std::iter_difference_t<I> len = tail - head; len > 0; len = tail - head) {
+
+      if (len > lazy.chunk && detail::work_wanted()) {
+
+        auto mid = head + (len / 2);
+
+        // clang-format off
+
+        co_await lf::fork(for_each)(head, mid, lazy, fun, proj);
+
+        LF_TRY {
+          co_await lf::call(for_each)(mid, tail, lazy, fun, proj);
+        } LF_CATCH_ALL { 
+          for_each.stash_exception(); 
+        }
+
+        // clang-format on
+
+        co_await lf::join;
+        co_return;
+      }
+
+      auto stop = head + std::min(len, std::iter_difference_t<I>(lazy.chunk));
+
+      for (; head != stop; ++head) {
+        co_await lf::just(fun)(co_await just(proj)(*head));
+      }
+    }
+  }
+
   /**
    * @brief Range version, dispatches to the iterator version.
    *
@@ -153,6 +200,53 @@ struct for_each_overload {
         std::ranges::begin(range), std::ranges::end(range), std::move(fun), std::move(proj) //
     );
   }
+
+  /**
+   * @brief Range lazy binary splitting version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range Range,
+            typename Proj = std::identity,
+            indirectly_unary_invocable<projected<std::ranges::iterator_t<Range>, Proj>> Fun>
+    requires std::ranges::sized_range<Range>
+  LF_STATIC_CALL auto operator()(auto for_each, Range &&range, lazy_split_t lazy, Fun fun, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::just(for_each)(
+        std::ranges::begin(range), std::ranges::end(range), lazy, std::move(fun), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Tiled version, halve the longest divisible dimension until each tile is within its grain.
+   */
+  template <std::size_t N, std::integral Int, invocable<blocked_range<N, Int>> Fun>
+  LF_STATIC_CALL auto
+  operator()(auto for_each, blocked_range<N, Int> range, Fun fun) LF_STATIC_CONST->lf::task<> {
+
+    if (range.empty()) {
+      co_return;
+    }
+
+    if (!range.is_divisible()) {
+      co_await lf::just(fun)(range);
+      co_return;
+    }
+
+    auto [lhs, rhs] = range.split();
+
+    // clang-format off
+
+    co_await lf::fork(for_each)(lhs, fun);
+
+    LF_TRY {
+      co_await lf::call(for_each)(rhs, fun);
+    } LF_CATCH_ALL { 
+      for_each.stash_exception(); 
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
 };
 
 } // namespace impl
@@ -174,7 +268,7 @@ struct for_each_overload {
  *    void for_each(I head, S tail, std::iter_difference_t<I> n, Fun fun, Proj proj = {});
  *
  * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
- * (which will set ``n = 1``).
+ * (which will set ``n = 1``) or, replaced by ``lf::lazy_split`` to choose the chunks at runtime.
  *
  * Exemplary usage:
  *
@@ -188,6 +282,9 @@ struct for_each_overload {
  *
  * This will set each element of `v` to `0` in parallel using a chunk size of ``10``.
  *
+ * An overload accepts an ``lf::blocked_range<N>`` (instead of a range and ``n``) in which case ``fun`` is
+ * invoked with each tile (also a ``blocked_range``), no projection is accepted.
+ *
  * If the function or projection handed to `for_each` are async functions, then they will be
  * invoked asynchronously, this allows you to launch further tasks recursively.
  *
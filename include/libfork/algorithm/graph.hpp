@@ -0,0 +1,333 @@
+#ifndef D2A7E4C1_8B35_4F60_9C1E_5A3F7B9D0E84
+#define D2A7E4C1_8B35_4F60_9C1E_5A3F7B9D0E84
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>      // for atomic, memory_order_acq_rel, memory_order_relaxed
+#include <concepts>    // for invocable
+#include <cstddef>     // for size_t
+#include <exception>   // for rethrow_exception
+#include <functional>  // for invoke
+#include <memory>      // for unique_ptr, make_unique
+#include <type_traits> // for decay_t, is_void_v
+#include <utility>     // for forward, move
+#include <vector>      // for vector
+
+#include "libfork/core/control_flow.hpp"   // for fork, join
+#include "libfork/core/eventually.hpp"     // for try_eventually
+#include "libfork/core/first_arg.hpp"      // for first_arg_t
+#include "libfork/core/impl/combinate.hpp" // for quasi_awaitable
+#include "libfork/core/impl/promise.hpp"   // for promise
+#include "libfork/core/impl/utility.hpp"   // for immovable, non_null
+#include "libfork/core/invocable.hpp"      // for async_tag_invocable, async_result_t
+#include "libfork/core/macro.hpp"          // for LF_TRY, LF_CATCH_ALL, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/tag.hpp"            // for tag, modifier
+#include "libfork/core/task.hpp"           // for task
+
+/**
+ * @file graph.hpp
+ *
+ * @brief A reusable graph of tasks with arbitrary (acyclic) dependencies.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief The return address of an asynchronous node.
+ */
+using graph_ret_t = try_eventually<void> *;
+
+/**
+ * @brief A type-erased node in a task graph.
+ *
+ * Exactly one of `launch` or `invoke` is set, depending on whether the node is an async function.
+ */
+struct graph_vertex : immovable<graph_vertex> {
+  /**
+   * @brief Produce an awaitable that calls an asynchronous node.
+   */
+  using launch_t = auto(graph_vertex const *self, graph_ret_t ret)
+                       -> quasi_awaitable<void, graph_ret_t, tag::call, modifier::none>;
+  /**
+   * @brief Call a regular node.
+   */
+  using invoke_t = void(graph_vertex const *self);
+
+  /**
+   * @brief Virtual destructor, the vertex owns the type-erased function.
+   */
+  virtual ~graph_vertex() = default;
+
+  /**
+   * @brief Set if the node is an async function.
+   */
+  launch_t *launch = nullptr;
+  /**
+   * @brief Set if the node is a regular function.
+   */
+  invoke_t *invoke = nullptr;
+  /**
+   * @brief The nodes that depend on this node.
+   */
+  std::vector<graph_vertex *> successors;
+  /**
+   * @brief The number of nodes this node depends on.
+   */
+  std::size_t in_degree = 0;
+  /**
+   * @brief The number of predecessors that have not yet completed in the current run.
+   */
+  std::atomic<std::size_t> pending = 0;
+};
+
+/**
+ * @brief Test if `F` can be a node of a task graph as an async function.
+ */
+template <typename F>
+concept async_graph_node = async_tag_invocable<graph_ret_t, tag::call, F> &&                 //
+                           std::invocable<F const &, first_arg_t<graph_ret_t, tag::call, F>> && //
+                           std::is_void_v<async_result_t<F>>;
+
+/**
+ * @brief Test if `F` can be a node of a task graph.
+ */
+template <typename F>
+concept graph_node = async_graph_node<F> || std::invocable<F const &>;
+
+/**
+ * @brief A vertex storing a node of type `F`.
+ */
+template <graph_node F>
+struct graph_vertex_for final : graph_vertex {
+
+  static auto launch_impl(graph_vertex const *self, graph_ret_t ret)
+      -> quasi_awaitable<void, graph_ret_t, tag::call, modifier::none> {
+
+    F const &fun = static_cast<graph_vertex_for const *>(self)->fun;
+
+    // Unlike `combinate` this invokes the stored function (not a temporary copy) hence, the captures of
+    // a lambda outlive the coroutine.
+    task<void> task = fun(first_arg_t<graph_ret_t, tag::call, F>(fun));
+
+    static_cast<promise<void, graph_ret_t, tag::call> *>(task.get())->set_return(std::move(ret));
+
+    return {{}, {std::move(task)}};
+  }
+
+  static void invoke_impl(graph_vertex const *self) {
+    std::invoke(static_cast<graph_vertex_for const *>(self)->fun);
+  }
+
+  /**
+   * @brief Store a copy of `f`.
+   */
+  template <typename G>
+  explicit graph_vertex_for(G &&f) : fun(std::forward<G>(f)) {
+    if constexpr (async_graph_node<F>) {
+      this->launch = &launch_impl;
+    } else {
+      this->invoke = &invoke_impl;
+    }
+  }
+
+  /**
+   * @brief The node's function.
+   */
+  [[no_unique_address]] F fun;
+};
+
+struct run_graph_overload;
+
+} // namespace impl
+
+/**
+ * @brief A directed acyclic graph of tasks, built once and run (by `lf::run_graph`) any number of times.
+ *
+ * Nodes are async functions (called with no arguments, returning `void`) or regular invocables. A node
+ * runs once all of the nodes that precede it have completed, each node has an atomic counter of
+ * outstanding predecessors and the predecessor that completes last forks the node.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    lf::task_graph graph;
+ *
+ *    auto load = graph.emplace([] { ... });
+ *    auto clean = graph.emplace([](auto) -> lf::task<> { ... });
+ *    auto save = graph.emplace([] { ... });
+ *
+ *    graph.precede(load, clean);
+ *    graph.precede(clean, save);
+ *
+ *    for (int i = 0; i < runs; ++i) {
+ *      lf::sync_wait(pool, lf::run_graph, graph);
+ *    }
+ *
+ * \endrst
+ *
+ * A graph must not be modified while it is running, nor run concurrently with itself. Handles to nodes
+ * remain valid if the graph is moved.
+ */
+class task_graph {
+ public:
+  /**
+   * @brief A handle to a node in a graph.
+   */
+  class node {
+   public:
+    /**
+     * @brief Compare handles.
+     */
+    auto operator==(node const &) const noexcept -> bool = default;
+
+   private:
+    friend class task_graph;
+
+    explicit node(impl::graph_vertex *vertex) noexcept : m_vertex{vertex} {}
+
+    impl::graph_vertex *m_vertex;
+  };
+
+  /**
+   * @brief Add a node that calls (a decay-copy of) `fun`, returns a handle to the new node.
+   */
+  template <typename F>
+    requires impl::graph_node<std::decay_t<F>>
+  auto emplace(F &&fun) -> node {
+    m_vertices.push_back(std::make_unique<impl::graph_vertex_for<std::decay_t<F>>>(std::forward<F>(fun)));
+    return node{m_vertices.back().get()};
+  }
+
+  /**
+   * @brief Add a dependency such that `after` does not start until `before` has completed.
+   */
+  void precede(node before, node after) {
+    LF_ASSERT(before != after);
+    non_null(before.m_vertex)->successors.push_back(non_null(after.m_vertex));
+    after.m_vertex->in_degree += 1;
+  }
+
+  /**
+   * @brief Get the number of nodes in the graph.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_vertices.size(); }
+
+ private:
+  friend struct impl::run_graph_overload;
+
+  std::vector<std::unique_ptr<impl::graph_vertex>> m_vertices;
+};
+
+namespace impl {
+
+/**
+ * @brief Run a node then, fork the successors it made ready and continue with the last of them.
+ */
+inline constexpr auto graph_exec = [](auto exec, graph_vertex *node) -> task<> {
+  //
+  for (;;) {
+
+    try_eventually<void> ret;
+
+    // clang-format off
+
+    LF_TRY {
+      if (node->launch != nullptr) {
+        co_await node->launch(node, &ret);
+      } else {
+        node->invoke(node);
+      }
+    } LF_CATCH_ALL {
+      exec.stash_exception();
+      break;
+    }
+
+    if (ret.has_exception()) {
+      LF_TRY {
+        std::rethrow_exception(std::move(ret).exception());
+      } LF_CATCH_ALL {
+        exec.stash_exception();
+      }
+      break;
+    }
+
+    // clang-format on
+
+    graph_vertex *next = nullptr;
+
+    for (graph_vertex *succ : node->successors) {
+      if (succ->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (next != nullptr) {
+          co_await lf::fork(exec)(next);
+        }
+        next = succ;
+      }
+    }
+
+    if (next == nullptr) {
+      break;
+    }
+
+    node = next;
+  }
+
+  co_await lf::join;
+};
+
+/**
+ * @brief Overload set for `lf::run_graph`.
+ */
+struct run_graph_overload {
+  /**
+   * @brief Reset the counters then, fork every node without predecessors.
+   */
+  LF_STATIC_CALL auto operator()(auto /* unused */, task_graph const &graph) LF_STATIC_CONST->lf::task<> {
+
+    for (auto &&vertex : graph.m_vertices) {
+      vertex->pending.store(vertex->in_degree, std::memory_order_relaxed);
+    }
+
+    for (auto &&vertex : graph.m_vertices) {
+      if (vertex->in_degree == 0) {
+        co_await lf::fork(graph_exec)(vertex.get());
+      }
+    }
+
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief An async function that runs every node of a `lf::task_graph` respecting its dependencies.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await lf::call(lf::run_graph)(graph);
+ *
+ * \endrst
+ *
+ * If a node throws then its successors are not run, the exception is rethrown (at the join) once the
+ * remaining nodes that could run have completed. The graph can be run again afterwards.
+ */
+inline constexpr impl::run_graph_overload run_graph = {};
+
+} // namespace lf
+
+#endif /* D2A7E4C1_8B35_4F60_9C1E_5A3F7B9D0E84 */
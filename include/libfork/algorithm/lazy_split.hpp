@@ -0,0 +1,90 @@
+#ifndef F4C1A8E2_7D36_4B9F_8E05_3A6D2C9B1E74
+#define F4C1A8E2_7D36_4B9F_8E05_3A6D2C9B1E74
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm> // for max
+#include <cstddef>   // for ptrdiff_t
+#include <thread>    // for thread
+
+#include "libfork/core/ext/context.hpp" // for full_context
+#include "libfork/core/ext/tls.hpp"     // for context
+#include "libfork/core/macro.hpp"       // for LF_ASSERT
+
+/**
+ * @file lazy_split.hpp
+ *
+ * @brief A chunk size for the algorithms that is chosen at runtime.
+ */
+
+namespace lf {
+
+/**
+ * @brief Pass ``lf::lazy_split`` in place of a chunk size to let the algorithms pick one at runtime.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[for_each](v, lf::lazy_split, [](auto &elem) {
+ *      elem = 0;
+ *    });
+ *
+ * \endrst
+ *
+ * This uses lazy binary splitting: a task works through its range serially, `chunk` elements at a time, and
+ * between chunks it checks if its worker's deque is empty. An empty deque means that any work this worker
+ * exposed has been stolen (or, that this worker is a thief) hence, other workers are hungry and the task
+ * splits the remaining range in half. When every worker is busy no tasks are forked, when workers are idle
+ * ranges are split as eagerly as the fixed chunk versions.
+ *
+ * The value of `chunk` is the smallest range that will be split, it only needs to be large enough to
+ * amortize a check of the deque, not a fork.
+ */
+struct lazy_split_t {
+  /**
+   * @brief The number of elements processed between checks for idle workers.
+   */
+  std::ptrdiff_t chunk = 64;
+};
+
+/**
+ * @brief A tag requesting lazy binary splitting with the default `chunk`.
+ */
+inline constexpr lazy_split_t lazy_split = {};
+
+namespace impl::detail {
+
+/**
+ * @brief Test if splitting would feed an idle worker, i.e. the calling worker's deque is empty.
+ */
+[[nodiscard]] inline auto work_wanted() noexcept -> bool { return tls::context()->empty(); }
+
+/**
+ * @brief A fixed chunk size for algorithms that cannot split lazily.
+ *
+ * Aims for roughly eight chunks per hardware thread but, not less than `lazy.chunk` elements per chunk.
+ */
+template <typename Int>
+[[nodiscard]] auto lazy_grain(lazy_split_t lazy, Int len) noexcept -> Int {
+
+  LF_ASSERT(lazy.chunk > 0);
+
+  Int per_thread = len / static_cast<Int>(8 * std::max(std::thread::hardware_concurrency(), 1U));
+
+  return std::max(per_thread, static_cast<Int>(lazy.chunk));
+}
+
+} // namespace impl::detail
+
+} // namespace lf
+
+#endif /* F4C1A8E2_7D36_4B9F_8E05_3A6D2C9B1E74 */
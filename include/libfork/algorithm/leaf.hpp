@@ -0,0 +1,305 @@
+#ifndef A6E3F0B9_5C18_4D72_B4A9_8F2E1D7C3B56
+#define A6E3F0B9_5C18_4D72_B4A9_8F2E1D7C3B56
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, ranges::min, ranges::max
+#include <array>       // for array
+#include <concepts>    // for same_as, integral
+#include <cstddef>     // for ptrdiff_t, size_t
+#include <cstring>     // for memcpy
+#include <functional>  // for plus, multiplies, identity, invoke
+#include <iterator>    // for random_access_iterator, contiguous_iterator, iter_reference_t, iter_difference_t
+#include <memory>      // for to_address
+#include <type_traits> // for is_arithmetic_v, remove_cvref_t
+
+#include "libfork/core/macro.hpp" // for LF_ASSERT, LF_PRAGMA_UNROLL, LF_VECTOR_EXTENSIONS
+
+/**
+ * @file leaf.hpp
+ *
+ * @brief Serial kernels for the leaves of the algorithms, specialised for well-known operators.
+ */
+
+namespace lf::impl::detail {
+
+/**
+ * @brief The type of `std::ranges::min`.
+ */
+using min_fn = std::remove_cvref_t<decltype(std::ranges::min)>;
+
+/**
+ * @brief The type of `std::ranges::max`.
+ */
+using max_fn = std::remove_cvref_t<decltype(std::ranges::max)>;
+
+/**
+ * @brief Test if `Bop` is a standard operator that is associative and commutative over the arithmetic `T`.
+ *
+ * Floating point addition and multiplication are treated as associative, the parallel algorithms already
+ * re-associate them. However, `std::ranges::min` and `std::ranges::max` return their first argument on
+ * ties and unordered comparisons, for floating point (e.g. NaN) the result would depend on how the lanes
+ * reorder the operands, hence these are only known over integral types.
+ */
+template <typename Bop, typename T>
+inline constexpr bool known_op_v = (std::is_arithmetic_v<T> && (std::same_as<Bop, std::plus<>> ||          //
+                                                                std::same_as<Bop, std::plus<T>> ||         //
+                                                                std::same_as<Bop, std::multiplies<>> ||    //
+                                                                std::same_as<Bop, std::multiplies<T>>)) || //
+                                   (std::integral<T> && (std::same_as<Bop, min_fn> ||                      //
+                                                         std::same_as<Bop, max_fn>));                      //
+
+/**
+ * @brief Verify a fold of `[I, I)` with `Bop` and `Proj` into an `Acc` can use `fold_lanes`.
+ */
+template <typename I, typename Bop, typename Proj, typename Acc>
+concept lane_foldable = std::random_access_iterator<I> &&                                   //
+                        std::same_as<Proj, std::identity> &&                                //
+                        std::same_as<std::remove_cvref_t<std::iter_reference_t<I>>, Acc> && //
+                        known_op_v<Bop, Acc>;                                               //
+
+/**
+ * @brief The number of independent accumulators `fold_lanes` uses for a `T`, enough to fill a few vectors.
+ */
+template <typename T>
+inline constexpr std::size_t k_fold_lanes = std::max(std::size_t{8}, 64 / sizeof(T));
+
+/**
+ * @brief Fold `[head, stop)` into `acc` using `k_fold_lanes` independent accumulators.
+ *
+ * A single accumulator is a serial dependency chain that compilers will not vectorize (for floating point)
+ * or, only poorly. Striping the input across independent lanes breaks the chain, the lanes are combined at
+ * the end.
+ */
+template <std::random_access_iterator I, typename T, typename Bop>
+  requires known_op_v<Bop, T>
+constexpr auto fold_lanes(T acc, I head, I stop, Bop &bop) -> T {
+
+  using diff_t = std::iter_difference_t<I>;
+
+  constexpr std::size_t k = k_fold_lanes<T>;
+  constexpr auto stride = static_cast<diff_t>(k);
+
+  if (stop - head >= stride) {
+
+    std::array<T, k> lane;
+
+    for (std::size_t j = 0; j < k; ++j) {
+      lane[j] = head[static_cast<diff_t>(j)];
+    }
+
+    for (head += stride; stop - head >= stride; head += stride) {
+      LF_PRAGMA_UNROLL(64)
+      for (std::size_t j = 0; j < k; ++j) {
+        lane[j] = std::invoke(bop, lane[j], head[static_cast<diff_t>(j)]);
+      }
+    }
+
+    for (std::size_t j = 0; j < k; ++j) {
+      acc = std::invoke(bop, acc, lane[j]);
+    }
+  }
+
+  for (; head != stop; ++head) {
+    acc = std::invoke(bop, acc, *head);
+  }
+
+  return acc;
+}
+
+/**
+ * @brief Fold `top(head[i]...)` for `i` in `[0, len)` using `k_fold_lanes` independent accumulators.
+ *
+ * This is `fold_lanes` with a transformation fused into the loads, requires `len > 0`. Like `fold_lanes`, the
+ * operands are striped across the lanes, hence their order is not preserved.
+ */
+template <typename T, typename Bop, typename Top, std::random_access_iterator... I>
+  requires known_op_v<Bop, T>
+constexpr auto transform_fold_lanes(std::ptrdiff_t len, Bop &bop, Top &top, I... head) -> T {
+
+  constexpr std::size_t k = k_fold_lanes<T>;
+  constexpr auto stride = static_cast<std::ptrdiff_t>(k);
+
+  auto at = [&](std::ptrdiff_t i) -> T {
+    return T(std::invoke(top, head[static_cast<std::iter_difference_t<I>>(i)]...));
+  };
+
+  LF_ASSERT(len > 0);
+
+  T acc{};
+
+  std::ptrdiff_t i = 0;
+
+  if (len < stride) {
+    acc = at(i++);
+  } else {
+
+    std::array<T, k> lane;
+
+    for (std::size_t j = 0; j < k; ++j) {
+      lane[j] = at(static_cast<std::ptrdiff_t>(j));
+    }
+
+    for (i = stride; len - i >= stride; i += stride) {
+      LF_PRAGMA_UNROLL(64)
+      for (std::size_t j = 0; j < k; ++j) {
+        lane[j] = std::invoke(bop, lane[j], at(i + static_cast<std::ptrdiff_t>(j)));
+      }
+    }
+
+    acc = lane[0];
+
+    for (std::size_t j = 1; j < k; ++j) {
+      acc = std::invoke(bop, acc, lane[j]);
+    }
+  }
+
+  for (; i < len; ++i) {
+    acc = std::invoke(bop, acc, at(i));
+  }
+
+  return acc;
+}
+
+/**
+ * @brief Test if `Bop` is addition or multiplication over `T`, the operators `scan_lanes` knows.
+ */
+template <typename Bop, typename T>
+inline constexpr bool lane_scan_op_v = std::same_as<Bop, std::plus<>> ||       //
+                                       std::same_as<Bop, std::plus<T>> ||      //
+                                       std::same_as<Bop, std::multiplies<>> || //
+                                       std::same_as<Bop, std::multiplies<T>>;  //
+
+/**
+ * @brief Verify an inclusive scan of `[I, I)` into `O` with `Bop` and `Proj` can use `scan_lanes`.
+ *
+ * Requires vector extensions and, a 4 or 8 byte arithmetic type (two or four to a 16 byte vector).
+ */
+template <typename I, typename O, typename Bop, typename Proj, typename Acc>
+concept lane_scannable = (LF_VECTOR_EXTENSIONS != 0) &&             //
+                         std::contiguous_iterator<I> &&             //
+                         std::contiguous_iterator<O> &&             //
+                         std::same_as<Proj, std::identity> &&       //
+                         std::same_as<std::iter_value_t<I>, Acc> && //
+                         std::same_as<std::iter_value_t<O>, Acc> && //
+                         std::is_arithmetic_v<Acc> &&               //
+                         !std::same_as<Acc, bool> &&                //
+                         (sizeof(Acc) == 4 || sizeof(Acc) == 8) &&  //
+                         lane_scan_op_v<Bop, Acc>;                  //
+
+#if LF_VECTOR_EXTENSIONS
+
+/**
+ * @brief A 16 byte vector of `T`.
+ */
+template <typename T>
+struct vec16 {
+  /**
+   * @brief The vector type.
+   */
+  typedef T type __attribute__((vector_size(16)));
+};
+
+/**
+ * @brief Scan `[head, stop)` into `out`, starting from `acc`, returns the end of the output.
+ *
+ * Each vector is scanned in-register with a log-step (shift and combine) then, the running total is
+ * broadcast and combined. Two vectors are processed per iteration so only one combine with the carry
+ * is on the critical path of every `2 * 16 / sizeof(T)` elements.
+ */
+template <typename T, typename Bop, std::contiguous_iterator I, std::contiguous_iterator O>
+  requires lane_scan_op_v<Bop, T>
+auto scan_lanes(T acc, I head, I stop, O out, Bop &bop) -> O {
+
+  using vec = typename vec16<T>::type;
+
+  constexpr auto w = static_cast<std::ptrdiff_t>(sizeof(vec) / sizeof(T));
+  constexpr bool mul = std::same_as<Bop, std::multiplies<>> || std::same_as<Bop, std::multiplies<T>>;
+
+  static_assert(w == 2 || w == 4);
+
+  vec const identity = vec{} + T(mul ? 1 : 0);
+
+  auto combine = [](vec lhs, vec rhs) -> vec {
+    if constexpr (mul) {
+      return lhs * rhs;
+    } else {
+      return lhs + rhs;
+    }
+  };
+
+  auto prefix = [&](vec x) -> vec {
+    if constexpr (w == 4) {
+      x = combine(x, __builtin_shufflevector(identity, x, 0, 4, 5, 6));
+      x = combine(x, __builtin_shufflevector(identity, x, 0, 1, 4, 5));
+    } else {
+      x = combine(x, __builtin_shufflevector(identity, x, 0, 2));
+    }
+    return x;
+  };
+
+  auto broadcast_last = [](vec x) -> vec {
+    if constexpr (w == 4) {
+      return __builtin_shufflevector(x, x, 3, 3, 3, 3);
+    } else {
+      return __builtin_shufflevector(x, x, 1, 1);
+    }
+  };
+
+  T const *src = std::to_address(head);
+  T *dst = std::to_address(out);
+
+  std::ptrdiff_t const len = stop - head;
+  std::ptrdiff_t i = 0;
+
+  vec carry = vec{} + acc;
+
+  for (; len - i >= 2 * w; i += 2 * w) {
+
+    vec lo;
+    vec hi;
+
+    std::memcpy(&lo, src + i, sizeof(vec));
+    std::memcpy(&hi, src + i + w, sizeof(vec));
+
+    lo = prefix(lo);
+    hi = combine(prefix(hi), broadcast_last(lo));
+
+    lo = combine(lo, carry);
+    hi = combine(hi, carry);
+
+    carry = broadcast_last(hi);
+
+    std::memcpy(dst + i, &lo, sizeof(vec));
+    std::memcpy(dst + i + w, &hi, sizeof(vec));
+  }
+
+  acc = carry[0];
+
+  for (; i < len; ++i) {
+    acc = std::invoke(bop, acc, src[i]);
+    dst[i] = acc;
+  }
+
+  return out + len;
+}
+
+#else
+
+/**
+ * @brief Never called, `lane_scannable` is never satisfied without vector extensions.
+ */
+template <typename T, typename Bop, std::contiguous_iterator I, std::contiguous_iterator O>
+auto scan_lanes(T acc, I head, I stop, O out, Bop &bop) -> O = delete;
+
+#endif
+
+} // namespace lf::impl::detail
+
+#endif /* A6E3F0B9_5C18_4D72_B4A9_8F2E1D7C3B56 */
@@ -9,11 +9,13 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>  // for min
 #include <functional> // for identity
 #include <iterator>   // for random_access_iterator, indirectly_copyable
 #include <ranges>     // for iterator_t, begin, end, random_access_range
 
 #include "libfork/algorithm/constraints.hpp" // for projected, indirectly_unary_invocable
+#include "libfork/algorithm/lazy_split.hpp"  // for lazy_split_t, work_wanted
 #include "libfork/core/control_flow.hpp"     // for call, fork, join
 #include "libfork/core/just.hpp"             // for just
 #include "libfork/core/macro.hpp"            // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
@@ -123,6 +125,52 @@ struct map_overload {
     }
   }
 
+  /**
+   * @brief Lazy binary splitting version, only splits when another worker is idle.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            typename Proj = std::identity,
+            indirectly_unary_invocable<projected<I, Proj>> Fun>
+    requires std::indirectly_copyable<projected<I, Proj, Fun>, O>
+  LF_STATIC_CALL auto
+  operator()(auto map, I head, S tail, O out, lazy_split_t lazy, Fun fun, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(lazy.chunk > 0);
+
+    for (std::iter_difference_t<I> len = tail - head; len > 0; len = tail - head) {
+
+      if (len > lazy.chunk && detail::work_wanted()) {
+
+        auto dif = (len / 2);
+        auto mid = head + dif;
+
+        // clang-format off
+
+        co_await lf::fork(map)(head, mid, out, lazy, fun, proj);
+
+        LF_TRY {
+          co_await lf::call(map)(mid, tail, out + dif, lazy, fun, proj);
+        } LF_CATCH_ALL { 
+          map.stash_exception(); 
+        }
+
+        // clang-format on
+
+        co_await lf::join;
+        co_return;
+      }
+
+      auto stop = head + std::min(len, std::iter_difference_t<I>(lazy.chunk));
+
+      for (; head != stop; ++head, ++out) {
+        *out = co_await lf::just(fun)(co_await just(proj)(*head));
+      }
+    }
+  }
+
   /**
    * @brief Range version, dispatches to the iterator version.
    *
@@ -165,6 +213,22 @@ struct map_overload {
         std::ranges::begin(range), std::ranges::end(range), out, std::move(fun), std::move(proj) //
     );
   }
+
+  /**
+   * @brief Range lazy binary splitting version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range Range,
+            std::random_access_iterator O,
+            typename Proj = std::identity,
+            indirectly_unary_invocable<projected<std::ranges::iterator_t<Range>, Proj>> Fun>
+    requires std::ranges::sized_range<Range> &&
+             std::indirectly_copyable<projected<std::ranges::iterator_t<Range>, Proj, Fun>, O>
+  LF_STATIC_CALL auto operator()(auto map, Range &&range, O out, lazy_split_t lazy, Fun fun, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::just(map)(
+        std::ranges::begin(range), std::ranges::end(range), out, lazy, std::move(fun), std::move(proj) //
+    );
+  }
 };
 
 } // namespace impl
@@ -188,7 +252,7 @@ struct map_overload {
  *    void map(I head, S tail, O out, std::iter_difference_t<I> n, Fun fun, Proj proj = {});
  *
  * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
- * (which will set ``n = 1``).
+ * (which will set ``n = 1``) or, replaced by ``lf::lazy_split`` to choose the chunks at runtime.
  *
  * Exemplary usage:
  *
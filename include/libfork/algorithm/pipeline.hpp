@@ -0,0 +1,428 @@
+#ifndef F3C8A1D6_7E24_4B9F_A05D_6B2E9C4F8A13
+#define F3C8A1D6_7E24_4B9F_A05D_6B2E9C4F8A13
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>      // for atomic, memory_order_relaxed
+#include <concepts>    // for invocable
+#include <cstddef>     // for size_t, ptrdiff_t
+#include <functional>  // for invoke
+#include <mutex>       // for lock_guard
+#include <optional>    // for optional
+#include <tuple>       // for tuple, get
+#include <type_traits> // for decay_t, invoke_result_t, is_void_v, type_identity
+#include <utility>     // for forward, move, index_sequence, index_sequence_for
+#include <vector>      // for vector
+
+#include "libfork/core/control_flow.hpp" // for fork, join
+#include "libfork/core/ext/handles.hpp"  // for submit_handle
+#include "libfork/core/impl/utility.hpp" // for immovable
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_TRY, LF_CATCH_ALL, LF_STATIC_CALL
+#include "libfork/core/task.hpp"         // for task
+#include "libfork/schedule/sync.hpp"     // for mutex, sync_awaitable, sync_spinlock, sync_waiter
+
+/**
+ * @file pipeline.hpp
+ *
+ * @brief A parallel pipeline of serial and parallel stages, similar to TBB's `parallel_pipeline`.
+ */
+
+namespace lf {
+
+/**
+ * @brief How a stage of an `lf::pipeline` may process items.
+ */
+enum class stage_mode {
+  /**
+   * @brief Items are processed concurrently, in any order.
+   */
+  parallel,
+  /**
+   * @brief Items are processed one at a time, in the order the source produced them.
+   */
+  serial_in_order,
+  /**
+   * @brief Items are processed one at a time, in any order.
+   */
+  serial_out_of_order,
+};
+
+namespace impl {
+
+/**
+ * @brief A stage of a pipeline, `fun` is called with the output of the previous stage.
+ */
+template <stage_mode Mode, typename F>
+struct pipeline_stage {
+  /**
+   * @brief The mode of this stage.
+   */
+  static constexpr stage_mode mode = Mode;
+  /**
+   * @brief The stage's function.
+   */
+  [[no_unique_address]] F fun;
+};
+
+// ---------------------------- Gates ---------------------------- //
+
+/**
+ * @brief An ``lf::core::context_switcher`` that never suspends.
+ */
+struct pipeline_pass {
+  /**
+   * @brief Never suspend.
+   */
+  static auto await_ready() noexcept -> bool { return true; }
+  /**
+   * @brief Unreachable.
+   */
+  static void await_suspend(submit_handle /* unused */) noexcept {}
+  /**
+   * @brief A no-op.
+   */
+  static void await_resume() noexcept {}
+};
+
+/**
+ * @brief Controls entry to a stage, parallel stages can always be entered.
+ */
+template <stage_mode Mode>
+struct pipeline_gate {
+  /**
+   * @brief Construct a gate for a pipeline with `tokens` in flight.
+   */
+  explicit pipeline_gate(std::size_t /* unused */) noexcept {}
+  /**
+   * @brief Enter the stage.
+   */
+  static auto enter(std::ptrdiff_t /* unused */) noexcept -> pipeline_pass { return {}; }
+  /**
+   * @brief Leave the stage.
+   */
+  static void leave() noexcept {}
+};
+
+/**
+ * @brief A serial out-of-order stage is guarded by a mutex.
+ */
+template <>
+struct pipeline_gate<stage_mode::serial_out_of_order>
+    : immovable<pipeline_gate<stage_mode::serial_out_of_order>> {
+  /**
+   * @brief Construct a gate for a pipeline with `tokens` in flight.
+   */
+  explicit pipeline_gate(std::size_t /* unused */) noexcept {}
+  /**
+   * @brief Enter the stage.
+   */
+  auto enter(std::ptrdiff_t /* unused */) noexcept { return m_mutex.lock(); }
+  /**
+   * @brief Leave the stage.
+   */
+  void leave() { m_mutex.unlock(); }
+
+ private:
+  lf::mutex m_mutex;
+};
+
+/**
+ * @brief A serial in-order stage admits items by sequence number.
+ *
+ * As the stage is in-order all the items produced after the next item to pass the stage are still in
+ * flight hence, their sequence numbers fit in a ring of `tokens` waiters.
+ */
+template <>
+struct pipeline_gate<stage_mode::serial_in_order>
+    : immovable<pipeline_gate<stage_mode::serial_in_order>> {
+  /**
+   * @brief Construct a gate for a pipeline with `tokens` in flight.
+   */
+  explicit pipeline_gate(std::size_t tokens) : m_ring(tokens, nullptr) {}
+  /**
+   * @brief Wait for the turn of item `seq`.
+   */
+  auto enter(std::ptrdiff_t seq) noexcept -> sync_awaitable<pipeline_gate> { return {this, seq}; }
+  /**
+   * @brief Pass the turn to the next item.
+   */
+  void leave() noexcept {
+
+    sync_waiter *next = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+      std::swap(next, slot(++m_next));
+    }
+
+    sync_resume_all(next);
+  }
+
+ private:
+  friend sync_awaitable<pipeline_gate>;
+
+  auto slot(std::ptrdiff_t seq) noexcept -> sync_waiter *& {
+    return m_ring[static_cast<std::size_t>(seq) % m_ring.size()];
+  }
+
+  auto try_ready(std::ptrdiff_t seq) noexcept -> bool {
+    std::lock_guard guard{m_spin};
+    return m_next == seq;
+  }
+
+  void suspend(std::ptrdiff_t seq, sync_waiter *waiter) noexcept {
+    {
+      std::lock_guard guard{m_spin};
+
+      if (m_next != seq) {
+        LF_ASSERT(slot(seq) == nullptr);
+        slot(seq) = waiter;
+        return;
+      }
+    }
+    // Our turn came between `try_ready` and here.
+    sync_resume_all(waiter);
+  }
+
+  sync_spinlock m_spin;
+  std::ptrdiff_t m_next = 0;
+  std::vector<sync_waiter *> m_ring;
+};
+
+// ---------------------------- Types ---------------------------- //
+
+/**
+ * @brief Test if `T` is a specialization of `std::optional`.
+ */
+template <typename T>
+inline constexpr bool is_optional_v = false;
+
+template <typename T>
+inline constexpr bool is_optional_v<std::optional<T>> = true;
+
+/**
+ * @brief The output of stage `S` given the input `T`.
+ */
+template <typename S, typename T>
+using stage_result_t = std::invoke_result_t<decltype(S::fun) &, T>;
+
+/**
+ * @brief Accumulate the (optional) input of every stage, the output of the last is discarded.
+ */
+template <typename Tuple, typename T, typename... Stages>
+struct pipeline_inputs;
+
+template <typename... Ts, typename T, typename S>
+struct pipeline_inputs<std::tuple<Ts...>, T, S> : std::type_identity<std::tuple<Ts..., std::optional<T>>> {
+  static_assert(std::invocable<decltype(S::fun) &, T>, "A stage cannot be called with its input");
+};
+
+template <typename... Ts, typename T, typename S, typename... Stages>
+struct pipeline_inputs<std::tuple<Ts...>, T, S, Stages...>
+    : pipeline_inputs<std::tuple<Ts..., std::optional<T>>, stage_result_t<S, T>, Stages...> {
+  static_assert(!std::is_void_v<stage_result_t<S, T>>, "Only the last stage may return void");
+};
+
+/**
+ * @brief The state shared by the tokens of a pipeline, lives in the frame of `lf::pipeline`.
+ */
+template <typename Source, typename... Stages>
+struct pipeline_state : immovable<pipeline_state<Source, Stages...>> {
+  /**
+   * @brief The type of the items produced by the source.
+   */
+  using item_type = typename std::invoke_result_t<Source &>::value_type;
+  /**
+   * @brief A tuple holding the input of each stage.
+   */
+  using inputs_type = typename pipeline_inputs<std::tuple<>, item_type, Stages...>::type;
+
+  /**
+   * @brief Construct the state for `tokens` in flight.
+   */
+  pipeline_state(std::size_t tokens, Source &src, std::tuple<Stages...> &stgs)
+      : source(src),
+        stages(stgs),
+        gates(((void)Stages::mode, tokens)...) {}
+
+  /**
+   * @brief Run stage `I` on its input (if there is one) then, leave the stage.
+   */
+  template <std::size_t I>
+  void run(auto const &token, inputs_type &in) {
+
+    if (auto &&item = std::get<I>(in)) {
+
+      auto &&fun = std::get<I>(stages).fun;
+
+      // clang-format off
+
+      LF_TRY {
+        if constexpr (I + 1 < sizeof...(Stages)) {
+          std::get<I + 1>(in).emplace(std::invoke(fun, *std::move(item)));
+        } else {
+          std::invoke(fun, *std::move(item));
+        }
+      } LF_CATCH_ALL {
+        token.stash_exception();
+        stop.store(true, std::memory_order_relaxed);
+      }
+
+      // clang-format on
+
+      item.reset();
+    }
+
+    std::get<I>(gates).leave();
+  }
+
+  /**
+   * @brief Produces the items, called with `input` held.
+   */
+  Source &source;
+  /**
+   * @brief The stages of the pipeline.
+   */
+  std::tuple<Stages...> &stages;
+  /**
+   * @brief Serializes calls to `source`.
+   */
+  lf::mutex input;
+  /**
+   * @brief The sequence number of the next item, guarded by `input`.
+   */
+  std::ptrdiff_t next = 0;
+  /**
+   * @brief Set once the source is exhausted or an exception is thrown.
+   */
+  std::atomic<bool> stop = false;
+  /**
+   * @brief A gate per stage.
+   */
+  std::tuple<pipeline_gate<Stages::mode>...> gates;
+};
+
+/**
+ * @brief A token, repeatedly takes an item from the source and carries it through every stage.
+ */
+inline constexpr auto pipeline_token =
+    []<typename State, std::size_t... I>(auto token, State *state, std::index_sequence<I...>) -> task<> {
+  //
+  for (;;) {
+
+    typename State::inputs_type in;
+
+    std::ptrdiff_t seq = 0;
+
+    co_await state->input.lock();
+
+    if (!state->stop.load(std::memory_order_relaxed)) {
+
+      // clang-format off
+
+      LF_TRY {
+        if (auto item = std::invoke(state->source)) {
+          std::get<0>(in).emplace(*std::move(item));
+          seq = state->next++;
+        } else {
+          state->stop.store(true, std::memory_order_relaxed);
+        }
+      } LF_CATCH_ALL {
+        token.stash_exception();
+        state->stop.store(true, std::memory_order_relaxed);
+      }
+
+      // clang-format on
+    }
+
+    state->input.unlock();
+
+    if (!std::get<0>(in)) {
+      break;
+    }
+
+    // An item that failed in an earlier stage still takes (and passes on) its turn at in-order stages.
+    ((co_await std::get<I>(state->gates).enter(seq), state->template run<I>(token, in)), ...);
+  }
+
+  co_await lf::join;
+};
+
+/**
+ * @brief Overload set for `lf::pipeline`.
+ */
+struct pipeline_overload {
+  /**
+   * @brief Fork `tokens` tokens then, wait for them to drain the source.
+   */
+  template <typename Source, stage_mode... Mode, typename... F>
+    requires std::invocable<Source &> && is_optional_v<std::invoke_result_t<Source &>> && (sizeof...(F) > 0)
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 std::size_t tokens,
+                                 Source source,
+                                 pipeline_stage<Mode, F>... stages) LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(tokens > 0);
+
+    std::tuple<pipeline_stage<Mode, F>...> tuple{std::move(stages)...};
+
+    pipeline_state<Source, pipeline_stage<Mode, F>...> state{tokens, source, tuple};
+
+    for (std::size_t i = 0; i < tokens; ++i) {
+      co_await lf::fork(pipeline_token)(&state, std::index_sequence_for<F...>{});
+    }
+
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief Make a stage of an `lf::pipeline`.
+ *
+ * The stage will call (a decay-copy of) `fun` with the output of the previous stage (or the source). The
+ * function of a parallel stage may be called concurrently.
+ */
+template <stage_mode Mode, typename F>
+auto stage(F &&fun) -> impl::pipeline_stage<Mode, std::decay_t<F>> {
+  return {std::forward<F>(fun)};
+}
+
+/**
+ * @brief An async function that streams items through a pipeline of stages.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await lf::call(lf::pipeline)(
+ *        tokens,
+ *        [&]() -> std::optional<record> { return parse_next(file); },
+ *        lf::stage<lf::stage_mode::parallel>([](record r) { return transform(r); }),
+ *        lf::stage<lf::stage_mode::serial_in_order>([&](result r) { write(out, r); })
+ *    );
+ *
+ * \endrst
+ *
+ * The source is called (serially) until it returns an empty optional, its items are numbered in the order
+ * they were produced. Each of the `tokens` tasks repeatedly takes an item from the source and carries it
+ * through every stage hence, at most `tokens` items are in flight. A task waiting for its turn at a
+ * serial stage is suspended, releasing its worker.
+ *
+ * If the source or a stage throws no more items are produced, the items in flight are drained (skipping
+ * the rest of the stages for the failed item) and the exception is rethrown.
+ */
+inline constexpr impl::pipeline_overload pipeline = {};
+
+} // namespace lf
+
+#endif /* F3C8A1D6_7E24_4B9F_A05D_6B2E9C4F8A13 */
@@ -0,0 +1,431 @@
+#ifndef C81F4A27_3E95_4B6D_A0C2_7D49E6B1F853
+#define C81F4A27_3E95_4B6D_A0C2_7D49E6B1F853
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, min, ranges::move, ranges::copy_n
+#include <array>       // for array
+#include <bit>         // for bit_cast
+#include <concepts>    // for integral, floating_point, unsigned_integral, signed_integral
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t, uint64_t
+#include <functional>  // for identity, invoke, plus
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, permutable, iter_value_t, ...
+#include <limits>      // for numeric_limits
+#include <memory>      // for make_unique_for_overwrite
+#include <ranges>      // for begin, end, iterator_t, random_access_range, sized_range, views::iota
+#include <thread>      // for thread
+#include <type_traits> // for make_unsigned_t, conditional_t, remove_cvref_t, is_trivially_copyable_v
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "libfork/algorithm/for_each.hpp" // for for_each
+#include "libfork/algorithm/scan.hpp"     // for scan
+#include "libfork/core/impl/utility.hpp"  // for k_cache_line
+#include "libfork/core/just.hpp"          // for just
+#include "libfork/core/macro.hpp"         // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"          // for task
+
+/**
+ * @file radix_sort.hpp
+ *
+ * @brief A parallel least-significant-digit radix sort.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief Integral types and IEEE-754 single/double precision floating point types.
+ */
+template <typename T>
+concept radix_key = std::integral<T> ||                                                    //
+                    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 && //
+                     (sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t)));
+
+/**
+ * @brief The unsigned integer that `T` is mapped to.
+ */
+template <radix_key T>
+using radix_uint_t = std::conditional_t<std::integral<T>,
+                                        std::make_unsigned_t<std::conditional_t<std::integral<T>, T, int>>,
+                                        std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+
+/**
+ * @brief Map a key to an unsigned integer such that the order of the keys is the order of the integers.
+ *
+ * Signed integers have their sign bit flipped, negative floats have all their bits flipped and positive
+ * floats just their sign bit. This orders `-0.0` before `+0.0` and NaNs by their sign.
+ */
+template <radix_key T>
+constexpr auto to_radix(T key) noexcept -> radix_uint_t<T> {
+
+  using U = radix_uint_t<T>;
+
+  constexpr U sign = U{1} << (std::numeric_limits<U>::digits - 1);
+
+  if constexpr (std::unsigned_integral<T>) {
+    return key;
+  } else if constexpr (std::signed_integral<T>) {
+    return static_cast<U>(static_cast<U>(key) ^ sign);
+  } else {
+    U bits = std::bit_cast<U>(key);
+    return static_cast<U>((bits & sign) != 0 ? ~bits : bits | sign);
+  }
+}
+
+/**
+ * @brief The key of `Proj` applied to the values of `I`.
+ */
+template <typename I, typename Proj>
+using radix_key_t = std::remove_cvref_t<std::indirect_result_t<Proj const &, I>>;
+
+/**
+ * @brief Test if `[I, I)` can be radix sorted by the key `Proj`.
+ */
+template <typename I, typename Proj>
+concept radix_sortable = std::permutable<I> &&                                      //
+                         std::indirectly_regular_unary_invocable<Proj const &, I> && //
+                         radix_key<radix_key_t<I, Proj>>;
+
+/**
+ * @brief The number of bits in a digit.
+ */
+inline constexpr int k_radix_bits = 8;
+
+/**
+ * @brief The number of buckets.
+ */
+inline constexpr std::size_t k_radix = std::size_t{1} << k_radix_bits;
+
+/**
+ * @brief The chunk-wise work of a single pass, moving `[src, src + len)` into `dst` ordered by one digit.
+ *
+ * Histograms are stored digit-major hence, an inclusive scan gives the end of each (digit, chunk) bucket.
+ */
+template <typename Src, typename Dst, typename Proj, typename Diff>
+struct radix_pass {
+
+  using value_type = std::iter_value_t<Src>;
+
+  /**
+   * @brief Buffer a cache line of values per bucket if the values are small and trivial.
+   */
+  static constexpr bool k_combine = std::is_trivially_copyable_v<value_type> &&              //
+                                    std::is_trivially_default_constructible_v<value_type> && //
+                                    sizeof(value_type) * 2 <= k_cache_line;
+
+  static constexpr std::size_t k_line = std::max(std::size_t{1}, k_cache_line / sizeof(value_type));
+
+  Src src;
+  Dst dst;
+  Diff len;
+  Diff n;
+  Diff chunks;
+  int shift;
+  Proj const *proj;
+  Diff *counts;
+  Diff *offsets;
+
+  [[nodiscard]] auto digit(auto const &value) const -> std::size_t {
+    return static_cast<std::size_t>(to_radix(std::invoke(*proj, value)) >> shift) & (k_radix - 1);
+  }
+
+  /**
+   * @brief Count the digits in chunk `c`.
+   */
+  void histogram(Diff c) const {
+
+    std::array<Diff, k_radix> hist{};
+
+    for (Diff i = c * n, end = std::min(len, i + n); i < end; ++i) {
+      ++hist[digit(src[i])];
+    }
+
+    for (std::size_t d = 0; d < k_radix; ++d) {
+      counts[static_cast<Diff>(d) * chunks + c] = hist[d];
+    }
+  }
+
+  /**
+   * @brief Move the elements of chunk `c` to their buckets.
+   */
+  void scatter(Diff c) const {
+
+    std::array<Diff, k_radix> pos;
+
+    for (std::size_t d = 0; d < k_radix; ++d) {
+      Diff i = static_cast<Diff>(d) * chunks + c;
+      pos[d] = offsets[i] - counts[i];
+    }
+
+    Diff const begin = c * n;
+    Diff const end = std::min(len, begin + n);
+
+    if constexpr (k_combine) {
+      // Write-combining, stage values in a line per bucket and write out whole lines.
+      alignas(k_cache_line) std::array<std::array<value_type, k_line>, k_radix> lines;
+      std::array<std::size_t, k_radix> fill{};
+
+      for (Diff i = begin; i < end; ++i) {
+
+        value_type const &value = src[i];
+
+        std::size_t d = digit(value);
+
+        lines[d][fill[d]++] = value;
+
+        if (fill[d] == k_line) {
+          std::ranges::copy(lines[d], dst + pos[d]);
+          pos[d] += static_cast<Diff>(k_line);
+          fill[d] = 0;
+        }
+      }
+
+      for (std::size_t d = 0; d < k_radix; ++d) {
+        std::ranges::copy_n(lines[d].begin(), static_cast<Diff>(fill[d]), dst + pos[d]);
+      }
+    } else {
+      for (Diff i = begin; i < end; ++i) {
+        dst[pos[digit(src[i])]++] = std::ranges::iter_move(src + i);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Run one pass, returns false (and does not move anything) if every key has the same digit.
+ */
+struct radix_pass_impl {
+  template <typename Src, typename Dst, typename Proj, typename Diff>
+  LF_STATIC_CALL auto operator()(auto /* unused */, radix_pass<Src, Dst, Proj, Diff> const *pass)
+      LF_STATIC_CONST->lf::task<bool> {
+
+    auto chunks = std::views::iota(Diff{0}, pass->chunks);
+
+    co_await lf::just(lf::for_each)(chunks, 1, [pass](Diff c) {
+      pass->histogram(c);
+    });
+
+    Diff const size = static_cast<Diff>(k_radix) * pass->chunks;
+    Diff const grain = std::max(size / static_cast<Diff>(k_radix), Diff{1});
+
+    co_await lf::just(lf::scan)(pass->counts, pass->counts + size, pass->offsets, grain, std::plus<>{});
+
+    for (std::size_t d = 0; d < k_radix; ++d) {
+
+      Diff const first = static_cast<Diff>(d) * pass->chunks;
+      Diff const total = pass->offsets[first + pass->chunks - 1] - (d == 0 ? 0 : pass->offsets[first - 1]);
+
+      if (total == pass->len) {
+        co_return false;
+      }
+    }
+
+    co_await lf::just(lf::for_each)(chunks, 1, [pass](Diff c) {
+      pass->scatter(c);
+    });
+
+    co_return true;
+  }
+};
+
+/**
+ * @brief Sort by each digit from least to most significant, moving the values between `head` and `buf`.
+ */
+struct radix_passes_impl {
+
+  template <typename I, typename B, typename Proj, typename Diff>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, B buf, bool in_buf, Diff len, Diff n, Proj const *proj)
+      LF_STATIC_CONST->lf::task<> {
+
+    constexpr int bits = std::numeric_limits<radix_uint_t<radix_key_t<I, Proj>>>::digits;
+
+    Diff const chunks = (len + n - 1) / n;
+
+    std::vector<Diff> counts(k_radix * static_cast<std::size_t>(chunks));
+    std::vector<Diff> offsets(counts.size());
+
+    for (int shift = 0; shift < bits; shift += k_radix_bits) {
+
+      bool moved = false;
+
+      if (in_buf) {
+        radix_pass<B, I, Proj, Diff> pass{
+            buf, head, len, n, chunks, shift, proj, counts.data(), offsets.data(),
+        };
+        moved = co_await lf::just(radix_pass_impl{})(&pass);
+      } else {
+        radix_pass<I, B, Proj, Diff> pass{
+            head, buf, len, n, chunks, shift, proj, counts.data(), offsets.data(),
+        };
+        moved = co_await lf::just(radix_pass_impl{})(&pass);
+      }
+
+      in_buf = moved != in_buf;
+    }
+
+    if (in_buf) {
+      co_await lf::just(lf::for_each)(std::views::iota(Diff{0}, chunks), 1, [=](Diff c) {
+        std::ranges::move(buf + c * n, buf + std::min(len, c * n + n), head + c * n);
+      });
+    }
+  }
+};
+
+/**
+ * @brief Allocate a buffer then, sort `[head, tail)`.
+ */
+struct radix_sort_impl {
+
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Proj proj)
+      LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(n > 0);
+
+    using value_t = std::iter_value_t<I>;
+
+    auto len = tail - head;
+
+    if (len < 2) {
+      co_return;
+    }
+
+    if constexpr (std::is_trivially_copyable_v<value_t> && //
+                  std::is_trivially_default_constructible_v<value_t>) {
+      // No need to initialize the buffer.
+      auto buf = std::make_unique_for_overwrite<value_t[]>(static_cast<std::size_t>(len));
+      co_await lf::just(radix_passes_impl{})(head, buf.get(), false, len, n, &proj);
+    } else {
+      // Move the input into the buffer, avoids tracking uninitialized elements.
+      std::vector<value_t> buf(std::make_move_iterator(head), std::make_move_iterator(head + len));
+      co_await lf::just(radix_passes_impl{})(head, buf.begin(), true, len, n, &proj);
+    }
+  }
+};
+
+/**
+ * @brief The chunk size used when none is given.
+ */
+template <typename Int>
+auto default_radix_grain(Int len) noexcept -> Int {
+  auto const workers = static_cast<Int>(std::max(std::thread::hardware_concurrency(), 1U));
+  return std::max(len / (4 * workers), Int{1} << 16);
+}
+
+/**
+ * @brief Overload set for `lf::radix_sort`.
+ */
+struct radix_sort_overload {
+  /**
+   * @brief Sort `[head, tail)` in chunks of `n`.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class Proj = std::identity>
+    requires radix_sortable<I, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::just(radix_sort_impl{})(std::move(head), std::move(tail), n, std::move(proj));
+  }
+
+  /**
+   * @brief Sort `[head, tail)` with a default chunk size.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class Proj = std::identity>
+    requires radix_sortable<I, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    auto n = default_radix_grain(tail - head);
+    co_await lf::just(radix_sort_impl{})(std::move(head), std::move(tail), n, std::move(proj));
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range, class Proj = std::identity>
+    requires std::ranges::sized_range<Range> && radix_sortable<std::ranges::iterator_t<Range>, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, Range &&range, std::ranges::range_difference_t<Range> n, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::just(radix_sort_impl{})(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range, class Proj = std::identity>
+    requires std::ranges::sized_range<Range> && radix_sortable<std::ranges::iterator_t<Range>, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, Range &&range, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    auto n = default_radix_grain(std::ranges::distance(range));
+    co_await lf::just(radix_sort_impl{})(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(proj) //
+    );
+  }
+};
+
+} // namespace detail
+
+} // namespace impl
+
+// clang-format off
+
+/**
+ * @brief A parallel, stable, radix sort of integral or floating point keys.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              typename Proj = std::identity
+ *              >
+ *      requires std::permutable<I> && radix_key<std::indirect_result_t<Proj const &, I>>
+ *    void radix_sort(I head, S tail, std::iter_difference_t<I> n, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will choose a chunk size based on the length of the input and the hardware concurrency).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[radix_sort](particles, &particle::morton_code);
+ *
+ * \endrst
+ *
+ * Where ``radix_key`` is an integral or IEEE-754 single/double precision floating point type (after
+ * removing references and cv-qualifiers). Values are sorted in ascending order of their key, one 8-bit digit
+ * per pass. Each pass counts the digits of every chunk (of ``n`` elements) in parallel, an ``lf::scan`` of
+ * the counts gives each chunk its offset into every bucket and then the chunks are scattered in parallel.
+ * Passes in which every key has the same digit are skipped. Small, trivially copyable values are staged in
+ * a cache line per bucket before being written out.
+ *
+ * Negative zero is ordered before positive zero and NaNs are ordered by their sign bit (i.e. negative NaNs
+ * first and positive NaNs last). This allocates a buffer the size of the input, if the elements are not
+ * trivially copyable the input is moved into the buffer first.
+ */
+inline constexpr impl::detail::radix_sort_overload radix_sort = {};
+
+// clang-format on
+
+} // namespace lf
+
+#endif /* C81F4A27_3E95_4B6D_A0C2_7D49E6B1F853 */
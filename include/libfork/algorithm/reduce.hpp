@@ -0,0 +1,368 @@
+#ifndef E7A2D5C8_3B61_4F0E_9D47_1C8B6A3E5F92
+#define E7A2D5C8_3B61_4F0E_9D47_1C8B6A3E5F92
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max
+#include <atomic>      // for atomic, memory_order_acquire, memory_order_relaxed
+#include <bit>         // for bit_ceil, countr_zero
+#include <concepts>    // for invocable
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t, uintptr_t
+#include <functional>  // for identity, invoke
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, iter_reference_t
+#include <mutex>       // for mutex, lock_guard
+#include <optional>    // for nullopt, optional
+#include <ranges>      // for begin, end, iterator_t, empty, random_access_range
+#include <thread>      // for thread
+#include <type_traits> // for decay_t, invoke_result_t
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "libfork/algorithm/constraints.hpp" // for projected, indirect_fold_acc_t, indirectly_foldable
+#include "libfork/core/control_flow.hpp"     // for call, fork, join
+#include "libfork/core/ext/context.hpp"      // for worker_context
+#include "libfork/core/ext/tls.hpp"          // for context
+#include "libfork/core/impl/utility.hpp"     // for k_cache_line, immovable
+#include "libfork/core/just.hpp"             // for just
+#include "libfork/core/macro.hpp"            // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"             // for task
+
+/**
+ * @file reduce.hpp
+ *
+ * @brief A parallel implementation of `std::reduce` for commutative operations.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief The accumulator of a single worker, padded to avoid false sharing.
+ */
+template <typename Acc>
+struct alignas(k_cache_line) reduce_slot {
+  /**
+   * @brief The worker that owns this slot, set once.
+   */
+  std::atomic<worker_context *> owner = nullptr;
+  /**
+   * @brief The fold of every chunk the owner has executed.
+   */
+  std::optional<Acc> acc;
+};
+
+/**
+ * @brief A small open-addressing table mapping workers to their accumulators.
+ *
+ * If there are more workers than slots the remaining workers share an accumulator guarded by a mutex.
+ */
+template <typename Acc>
+class reduce_table : immovable<reduce_table<Acc>> {
+ public:
+  /**
+   * @brief Construct a table with room for (at least) twice the hardware concurrency.
+   */
+  reduce_table()
+      : m_slots(std::bit_ceil(std::max(2 * std::thread::hardware_concurrency(), 2U))),
+        m_shift(64 - std::countr_zero(m_slots.size())) {}
+
+  /**
+   * @brief Get the accumulator of the calling worker, ``nullptr`` if the table is full.
+   */
+  auto find() noexcept -> std::optional<Acc> * {
+
+    worker_context *self = tls::context();
+
+    auto hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(self)) * 0x9e3779b97f4a7c15ULL;
+
+    std::size_t mask = m_slots.size() - 1;
+
+    for (std::size_t i = 0, idx = hash >> m_shift; i <= mask; ++i, idx = (idx + 1) & mask) {
+
+      worker_context *owner = m_slots[idx].owner.load(std::memory_order_acquire);
+
+      if (owner == nullptr) {
+        // Relaxed is fine, the slot is only ever accessed by its owner until after the join.
+        if (m_slots[idx].owner.compare_exchange_strong(owner, self, std::memory_order_relaxed)) {
+          return &m_slots[idx].acc;
+        }
+      }
+
+      if (owner == self) {
+        return &m_slots[idx].acc;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Merge `acc` into the shared accumulator, for workers without a slot.
+   */
+  template <typename Bop>
+  void overflow(Acc acc, Bop &bop) {
+
+    std::lock_guard lock{m_mutex};
+
+    if (m_overflow) {
+      *m_overflow = std::invoke(bop, *std::move(m_overflow), std::move(acc));
+    } else {
+      m_overflow.emplace(std::move(acc));
+    }
+  }
+
+  /**
+   * @brief Combine the accumulators, one invocation of `bop` per worker.
+   */
+  template <typename Bop>
+  auto collect(Bop &bop) -> std::optional<Acc> {
+
+    std::optional<Acc> out = std::move(m_overflow);
+
+    for (auto &&slot : m_slots) {
+      if (slot.acc) {
+        if (out) {
+          *out = std::invoke(bop, *std::move(out), *std::move(slot.acc));
+        } else {
+          out.emplace(*std::move(slot.acc));
+        }
+      }
+    }
+
+    return out;
+  }
+
+ private:
+  std::vector<reduce_slot<Acc>> m_slots;
+  int m_shift;
+  std::mutex m_mutex;
+  std::optional<Acc> m_overflow;
+};
+
+/**
+ * @brief Test if `Bop` and `Proj` can be used by `lf::reduce`, unlike `lf::fold` they must be regular.
+ */
+template <class Bop, class I, class Proj>
+concept reducible =                                                                             //
+    indirectly_foldable<Bop, projected<I, Proj>> &&                                             //
+    std::invocable<Proj &, std::iter_reference_t<I>> &&                                         //
+    std::invocable<Bop &,                                                                       //
+                   indirect_fold_acc_t<Bop, I, Proj>,                                           //
+                   std::invoke_result_t<Proj &, std::iter_reference_t<I>>> &&                   //
+    std::invocable<Bop &, indirect_fold_acc_t<Bop, I, Proj>, indirect_fold_acc_t<Bop, I, Proj>>; //
+
+template <std::random_access_iterator I,
+          std::sized_sentinel_for<I> S,
+          class Proj,
+          indirectly_foldable<projected<I, Proj>> Bop>
+struct reduce_overload_impl {
+
+  using acc_t = indirect_fold_acc_t<Bop, I, Proj>;
+  using int_t = std::iter_difference_t<I>;
+
+  /**
+   * @brief Fold `[head, tail)` into the accumulator of the current worker.
+   *
+   * This never suspends hence, the worker cannot change (or run another chunk) while it holds its slot.
+   */
+  static void leaf(I head, S tail, Bop &bop, Proj &proj, reduce_table<acc_t> *table) {
+
+    std::optional<acc_t> *slot = table->find();
+
+    acc_t acc = slot && *slot ? std::move(**slot) : acc_t(std::invoke(proj, *head++));
+
+    for (; head != tail; ++head) {
+      acc = std::invoke(bop, std::move(acc), std::invoke(proj, *head));
+    }
+
+    if (slot) {
+      *slot = std::move(acc);
+    } else {
+      table->overflow(std::move(acc), bop);
+    }
+  }
+
+  /**
+   * @brief Reduce `[head, tail)` into a table then, combine the table.
+   */
+  LF_STATIC_CALL auto operator()(auto reduce, I head, S tail, int_t n, Bop bop, Proj proj)
+      LF_STATIC_CONST->lf::task<std::optional<acc_t>> {
+
+    if (head == tail) {
+      co_return std::nullopt;
+    }
+
+    reduce_table<acc_t> table;
+
+    co_await lf::call(reduce)(std::move(head), std::move(tail), n, bop, proj, &table);
+    co_await lf::join;
+
+    co_return table.collect(bop);
+  }
+
+  /**
+   * @brief Recursive implementation of `reduce`, requires that `tail - head > 0`.
+   */
+  LF_STATIC_CALL auto
+  operator()(auto reduce, I head, S tail, int_t n, Bop bop, Proj proj, reduce_table<acc_t> *table)
+      LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(n > 0);
+
+    int_t len = tail - head;
+
+    LF_ASSERT(len > 0);
+
+    if (len <= n) {
+      leaf(std::move(head), std::move(tail), bop, proj, table);
+      co_return;
+    }
+
+    auto mid = head + (len / 2);
+
+    // clang-format off
+
+    co_await lf::fork(reduce)(head, mid, n, bop, proj, table);
+
+    LF_TRY {
+      co_await lf::call(reduce)(mid, tail, n, bop, proj, table);
+    } LF_CATCH_ALL {
+      reduce.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Overload set for `lf::reduce`.
+ */
+struct reduce_overload {
+  /**
+   * @brief Reduce in chunks of one.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            class Bop>
+    requires detail::reducible<Bop, I, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::optional<indirect_fold_acc_t<Bop, I, Proj>>> {
+    co_return co_await lf::just(detail::reduce_overload_impl<I, S, Proj, Bop>{})(
+        std::move(head), std::move(tail), 1, std::move(bop), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Reduce in chunks of `n`.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            class Bop>
+    requires detail::reducible<Bop, I, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::optional<indirect_fold_acc_t<Bop, I, Proj>>> {
+    co_return co_await lf::just(detail::reduce_overload_impl<I, S, Proj, Bop>{})(
+        std::move(head), std::move(tail), n, std::move(bop), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range, class Proj = std::identity, class Bop>
+    requires std::ranges::sized_range<Range> && detail::reducible<Bop, std::ranges::iterator_t<Range>, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, Range &&range, Bop bop, Proj proj = {}) LF_STATIC_CONST
+      ->lf::task<std::optional<indirect_fold_acc_t<Bop, std::ranges::iterator_t<Range>, Proj>>> {
+
+    using I = std::decay_t<decltype(std::ranges::begin(range))>;
+    using S = std::decay_t<decltype(std::ranges::end(range))>;
+
+    co_return co_await lf::just(detail::reduce_overload_impl<I, S, Proj, Bop>{})(
+        std::ranges::begin(range), std::ranges::end(range), 1, std::move(bop), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range, class Proj = std::identity, class Bop>
+    requires std::ranges::sized_range<Range> && detail::reducible<Bop, std::ranges::iterator_t<Range>, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 Range &&range,
+                                 std::ranges::range_difference_t<Range> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST
+      ->lf::task<std::optional<indirect_fold_acc_t<Bop, std::ranges::iterator_t<Range>, Proj>>> {
+
+    using I = std::decay_t<decltype(std::ranges::begin(range))>;
+    using S = std::decay_t<decltype(std::ranges::end(range))>;
+
+    co_return co_await lf::just(detail::reduce_overload_impl<I, S, Proj, Bop>{})(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(bop), std::move(proj) //
+    );
+  }
+};
+
+} // namespace impl
+
+// clang-format off
+
+/**
+ * @brief A parallel implementation of `std::reduce` (without an initial value).
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              typename Proj = std::identity,
+ *              indirectly_foldable<projected<I, Proj>> Bop
+ *              >
+ *    auto reduce(I head, S tail, std::iter_difference_t<I> n, Bop bop, Proj proj = {}) -> std::optional<indirect_fold_acc_t<Bop, I, Proj>>;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 1``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::optional<unsigned> sum = co_await just[reduce](v, 1024, std::plus<>{});
+ *
+ * \endrst
+ *
+ * Unlike `lf::fold` the binary operator must be associative *and* commutative. Each worker folds the
+ * chunks (of size ``n``) it executes into its own accumulator, the accumulators are combined (one
+ * invocation of `bop` per worker) after every chunk has completed. Hence, the tree of joins does not
+ * combine any values which makes this significantly faster than `lf::fold` for cheap operators.
+ *
+ * The binary operator and projection must be regular (not async) functions. This function will make an
+ * implementation defined number of copies of the function objects and may invoke these copies concurrently.
+ */
+inline constexpr impl::reduce_overload reduce = {};
+
+// clang-format on
+
+} // namespace lf
+
+#endif /* E7A2D5C8_3B61_4F0E_9D47_1C8B6A3E5F92 */
@@ -0,0 +1,339 @@
+#ifndef A6D3F8B1_5C72_4E09_8A1D_2F7B9E4C6A35
+#define A6D3F8B1_5C72_4E09_8A1D_2F7B9E4C6A35
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, ranges::sort, ranges::stable_sort, ranges::lower_bound, ...
+#include <functional>  // for invoke, ranges::less, identity
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, sortable, iter_value_t, ...
+#include <memory>      // for make_unique_for_overwrite
+#include <ranges>      // for begin, end, iterator_t, random_access_range, sized_range
+#include <thread>      // for thread
+#include <type_traits> // for is_trivially_copyable_v, is_trivially_default_constructible_v
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "libfork/core/control_flow.hpp" // for call, fork, join
+#include "libfork/core/just.hpp"         // for just
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"         // for task
+
+/**
+ * @file sort.hpp
+ *
+ * @brief Parallel implementations of `std::sort` and `std::stable_sort`.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief Merge (moving) the sorted ranges `[l, l_end)` and `[r, r_end)` into `out`.
+ */
+struct merge_impl {
+  /**
+   * @brief Split the larger range at its midpoint and the other range around that element.
+   *
+   * This is stable, elements of the left range are ordered before equivalent elements of the right range.
+   */
+  template <typename In, typename Out, typename Comp, typename Proj>
+  LF_STATIC_CALL auto operator()(auto merge,
+                                 In l,
+                                 In l_end,
+                                 In r,
+                                 In r_end,
+                                 Out out,
+                                 std::iter_difference_t<In> n,
+                                 Comp comp,
+                                 Proj proj) LF_STATIC_CONST->lf::task<> {
+
+    auto l_len = l_end - l;
+    auto r_len = r_end - r;
+
+    if (l_len + r_len <= n) {
+
+      for (; l != l_end && r != r_end; ++out) {
+        if (std::invoke(comp, std::invoke(proj, *r), std::invoke(proj, *l))) {
+          *out = std::ranges::iter_move(r++);
+        } else {
+          *out = std::ranges::iter_move(l++);
+        }
+      }
+
+      std::ranges::move(r, r_end, std::ranges::move(l, l_end, out).out);
+
+      co_return;
+    }
+
+    In l_mid;
+    In r_mid;
+
+    // The pivot is moved to its final position and excluded from both halves hence, each half is smaller.
+    bool const left = l_len >= r_len;
+
+    if (left) {
+      l_mid = l + l_len / 2;
+      r_mid = std::ranges::lower_bound(r, r_end, std::invoke(proj, *l_mid), comp, proj);
+    } else {
+      r_mid = r + r_len / 2;
+      l_mid = std::ranges::upper_bound(l, l_end, std::invoke(proj, *r_mid), comp, proj);
+    }
+
+    Out out_mid = out + (l_mid - l) + (r_mid - r);
+
+    *out_mid = std::ranges::iter_move(left ? l_mid : r_mid);
+
+    In l_tail = left ? l_mid + 1 : l_mid;
+    In r_tail = left ? r_mid : r_mid + 1;
+
+    // clang-format off
+
+    co_await lf::fork(merge)(l, l_mid, r, r_mid, out, n, comp, proj);
+
+    LF_TRY {
+      co_await lf::call(merge)(l_tail, l_end, r_tail, r_end, out_mid + 1, n, comp, proj);
+    } LF_CATCH_ALL {
+      merge.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief A merge sort that alternates between the input and a buffer of the same length.
+ */
+template <bool Stable>
+struct sort_impl {
+  /**
+   * @brief Sort `[x, x + len)` leaving the result in `y` if `into_y` otherwise, in `x`.
+   */
+  template <typename X, typename Y, typename Comp, typename Proj>
+  LF_STATIC_CALL auto operator()(auto sort,
+                                 X x,
+                                 Y y,
+                                 std::iter_difference_t<X> len,
+                                 std::iter_difference_t<X> n,
+                                 bool into_y,
+                                 Comp comp,
+                                 Proj proj) LF_STATIC_CONST->lf::task<> {
+
+    if (len <= n) {
+
+      if constexpr (Stable) {
+        std::ranges::stable_sort(x, x + len, comp, proj);
+      } else {
+        std::ranges::sort(x, x + len, comp, proj);
+      }
+
+      if (into_y) {
+        std::ranges::move(x, x + len, y);
+      }
+
+      co_return;
+    }
+
+    auto half = len / 2;
+
+    // clang-format off
+
+    // Sort the halves into the other range then, merge them back.
+    co_await lf::fork(sort)(x, y, half, n, !into_y, comp, proj);
+
+    LF_TRY {
+      co_await lf::call(sort)(x + half, y + half, len - half, n, !into_y, comp, proj);
+    } LF_CATCH_ALL {
+      sort.stash_exception();
+    }
+
+    co_await lf::join;
+
+    if (into_y) {
+      co_await lf::call(merge_impl{})(x, x + half, x + half, x + len, y, n, comp, proj);
+    } else {
+      co_await lf::call(merge_impl{})(y, y + half, y + half, y + len, x, n, comp, proj);
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Allocate a buffer then, sort `[head, tail)`.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename Comp, typename Proj>
+  LF_STATIC_CALL auto operator()(auto sort, I head, S tail, std::iter_difference_t<I> n, Comp comp, Proj proj)
+      LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(n > 0);
+
+    auto len = tail - head;
+
+    if (len <= n) {
+      co_await lf::call(sort)(head, head, len, n, false, std::move(comp), std::move(proj));
+      co_await lf::join;
+      co_return;
+    }
+
+    using value_t = std::iter_value_t<I>;
+
+    if constexpr (std::is_trivially_copyable_v<value_t> && //
+                  std::is_trivially_default_constructible_v<value_t>) {
+      // No need to initialize the buffer.
+      auto buf = std::make_unique_for_overwrite<value_t[]>(static_cast<std::size_t>(len));
+      co_await lf::call(sort)(head, buf.get(), len, n, false, std::move(comp), std::move(proj));
+      co_await lf::join;
+    } else {
+      // Move the input into the buffer and sort it back, avoids tracking uninitialized elements.
+      std::vector<value_t> buf(std::make_move_iterator(head), std::make_move_iterator(head + len));
+      co_await lf::call(sort)(buf.begin(), head, len, n, true, std::move(comp), std::move(proj));
+      co_await lf::join;
+    }
+  }
+};
+
+/**
+ * @brief The serial cutoff used when none is given.
+ */
+template <typename Int>
+auto default_sort_grain(Int len) noexcept -> Int {
+  return std::max(len / static_cast<Int>(8 * std::max(std::thread::hardware_concurrency(), 1U)), Int{2048});
+}
+
+/**
+ * @brief Overload set for `lf::sort` and `lf::stable_sort`.
+ */
+template <bool Stable>
+struct sort_overload {
+  /**
+   * @brief Sort `[head, tail)` with a serial cutoff of `n`.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Comp = std::ranges::less,
+            class Proj = std::identity>
+    requires std::sortable<I, Comp, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::just(sort_impl<Stable>{})(
+        std::move(head), std::move(tail), n, std::move(comp), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Sort `[head, tail)` with a default serial cutoff.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Comp = std::ranges::less,
+            class Proj = std::identity>
+    requires std::sortable<I, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    auto n = default_sort_grain(tail - head);
+    co_await lf::just(sort_impl<Stable>{})(
+        std::move(head), std::move(tail), n, std::move(comp), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Comp = std::ranges::less,
+            class Proj = std::identity>
+    requires std::ranges::sized_range<Range> && std::sortable<std::ranges::iterator_t<Range>, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 Range &&range,
+                                 std::ranges::range_difference_t<Range> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::just(sort_impl<Stable>{})(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(comp), std::move(proj) //
+    );
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range Range,
+            class Comp = std::ranges::less,
+            class Proj = std::identity>
+    requires std::ranges::sized_range<Range> && std::sortable<std::ranges::iterator_t<Range>, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, Range &&range, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    auto n = default_sort_grain(std::ranges::distance(range));
+    co_await lf::just(sort_impl<Stable>{})(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(comp), std::move(proj) //
+    );
+  }
+};
+
+} // namespace detail
+
+} // namespace impl
+
+// clang-format off
+
+/**
+ * @brief A parallel implementation of `std::ranges::sort`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              typename Comp = std::ranges::less,
+ *              typename Proj = std::identity
+ *              >
+ *      requires std::sortable<I, Comp, Proj>
+ *    void sort(I head, S tail, std::iter_difference_t<I> n, Comp comp = {}, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will choose a cutoff based on the length of the input and the hardware concurrency).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[sort](v, std::ranges::greater{});
+ *
+ * \endrst
+ *
+ * This is a merge sort, chunks of at most ``n`` elements are sorted serially and merged with a parallel
+ * (divide and conquer) merge. This allocates a buffer the size of the input, if the elements are not
+ * trivially copyable and trivially default constructible the input is moved into the buffer first.
+ *
+ * This function will make an implementation defined number of copies of the function objects and may
+ * invoke these copies concurrently.
+ */
+inline constexpr impl::detail::sort_overload<false> sort = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::stable_sort`.
+ *
+ * The same as `lf::sort` except, the relative order of equivalent elements is preserved.
+ */
+inline constexpr impl::detail::sort_overload<true> stable_sort = {};
+
+// clang-format on
+
+} // namespace lf
+
+#endif /* A6D3F8B1_5C72_4E09_8A1D_2F7B9E4C6A35 */
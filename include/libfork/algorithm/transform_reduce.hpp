@@ -0,0 +1,417 @@
+#ifndef A2B60D92_AEAB_4C96_B322_208EC97836FA
+#define A2B60D92_AEAB_4C96_B322_208EC97836FA
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <concepts>    // for convertible_to, invocable, movable
+#include <cstddef>     // for ptrdiff_t
+#include <functional>  // for invoke, multiplies, plus
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, iter_difference_t
+#include <ranges>      // for begin, end, distance, iterator_t, random_access_range
+#include <type_traits> // for common_type_t, invoke_result_t
+#include <utility>     // for move
+
+#include "libfork/algorithm/leaf.hpp"    // for known_op_v, transform_fold_lanes
+#include "libfork/core/control_flow.hpp" // for call, fork, join
+#include "libfork/core/eventually.hpp"   // for eventually
+#include "libfork/core/just.hpp"         // for just
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"         // for task
+
+/**
+ * @file transform_reduce.hpp
+ *
+ * @brief A parallel implementation of `std::transform_reduce`.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief Test if `T`, `Bop` and `Top` can be used by `lf::transform_reduce` over `I...`.
+ *
+ * Like `lf::reduce`, the operators must be regular functions.
+ */
+template <class T, class Bop, class Top, class... I>
+concept transform_reducible =                                                           //
+    std::movable<T> &&                                                                  //
+    std::invocable<Top &, std::iter_reference_t<I>...> &&                               //
+    std::convertible_to<std::invoke_result_t<Top &, std::iter_reference_t<I>...>, T> && //
+    std::invocable<Bop &, T, T> &&                                                      //
+    std::convertible_to<std::invoke_result_t<Bop &, T, T>, T>;                          //
+
+/**
+ * @brief Recursive implementation of `transform_reduce`, reduces `top(head[i]...)` for `i` in `[0, len)`.
+ */
+template <class Int, class T, class Bop, class Top, std::random_access_iterator... I>
+struct transform_reduce_impl {
+
+  /**
+   * @brief Reduce a chunk, outside of the coroutine frame so the accumulators can live in registers.
+   *
+   * Well-known operators over arithmetic types are dispatched to a multi-accumulator kernel.
+   */
+  static auto leaf(Int len, Bop &bop, Top &top, I... head) -> T {
+    if constexpr (detail::known_op_v<Bop, T>) {
+      return detail::transform_fold_lanes<T>(static_cast<std::ptrdiff_t>(len), bop, top, head...);
+    } else {
+      T acc = T(std::invoke(top, *head...));
+
+      for (Int i = 1; i < len; ++i) {
+        acc = std::invoke(bop, std::move(acc), T(std::invoke(top, head[i]...)));
+      }
+
+      return acc;
+    }
+  }
+
+  /**
+   * @brief Requires that `len > 0`.
+   */
+  LF_STATIC_CALL auto operator()(auto self, Int len, Int n, Bop bop, Top top, I... head)
+      LF_STATIC_CONST->lf::task<T> {
+
+    LF_ASSERT(len > 0);
+
+    if (len <= n) {
+      co_return leaf(len, bop, top, head...);
+    }
+
+    Int mid = len / 2;
+
+    eventually<T> lhs;
+    eventually<T> rhs;
+
+    // clang-format off
+
+    co_await lf::fork(&lhs, self)(mid, n, bop, top, head...);
+
+    LF_TRY {
+      co_await lf::call(&rhs, self)(len - mid, n, bop, top, (head + mid)...);
+    } LF_CATCH_ALL {
+      self.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+
+    co_return std::invoke(bop, *std::move(lhs), *std::move(rhs));
+  }
+};
+
+/**
+ * @brief Checks for empty input then, combines the reduction with `init`.
+ */
+struct transform_reduce_root {
+  /**
+   * @brief Reduce `top(head[i]...)` for `i` in `[0, len)` in chunks of `n` and, combine with `init`.
+   */
+  template <class T, class Bop, class Top, std::random_access_iterator... I>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 std::common_type_t<std::iter_difference_t<I>...> len,
+                                 std::common_type_t<std::iter_difference_t<I>...> n,
+                                 T init,
+                                 Bop bop,
+                                 Top top,
+                                 I... head) LF_STATIC_CONST->lf::task<T> {
+
+    using int_t = std::common_type_t<std::iter_difference_t<I>...>;
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(len >= 0);
+
+    if (len == 0) {
+      co_return std::move(init);
+    }
+
+    using impl = transform_reduce_impl<int_t, T, Bop, Top, I...>;
+
+    T sum = co_await lf::just(impl{})(len, n, bop, top, head...);
+
+    co_return std::invoke(bop, std::move(init), std::move(sum));
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Twelve overloads of transform_reduce for (iterator/range, unary/binary/dot-product, n = 1/n != 1).
+ */
+struct transform_reduce_overload {
+  /**
+   * @brief [iterator,binary,chunk] version.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            class T,
+            class Bop,
+            class Top>
+    requires detail::transform_reducible<T, Bop, Top, I1, I2>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I1 head1,
+                                 S1 tail1,
+                                 I2 head2,
+                                 std::iter_difference_t<I1> n,
+                                 T init,
+                                 Bop bop,
+                                 Top top) LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        tail1 - head1, n, std::move(init), std::move(bop), std::move(top), head1, head2 //
+    );
+  }
+  /**
+   * @brief [iterator,binary,n = 1] version.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            class T,
+            class Bop,
+            class Top>
+    requires detail::transform_reducible<T, Bop, Top, I1, I2>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I1 head1, S1 tail1, I2 head2, T init, Bop bop, Top top) LF_STATIC_CONST
+      ->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        tail1 - head1, 1, std::move(init), std::move(bop), std::move(top), head1, head2 //
+    );
+  }
+  /**
+   * @brief [iterator,dot-product,chunk] version.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            class T>
+    requires detail::transform_reducible<T, std::plus<>, std::multiplies<>, I1, I2>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I1 head1, S1 tail1, I2 head2, std::iter_difference_t<I1> n, T init)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        tail1 - head1, n, std::move(init), std::plus<>{}, std::multiplies<>{}, head1, head2 //
+    );
+  }
+  /**
+   * @brief [iterator,dot-product,n = 1] version.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            class T>
+    requires detail::transform_reducible<T, std::plus<>, std::multiplies<>, I1, I2>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I1 head1, S1 tail1, I2 head2, T init)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        tail1 - head1, 1, std::move(init), std::plus<>{}, std::multiplies<>{}, head1, head2 //
+    );
+  }
+  /**
+   * @brief [iterator,unary,chunk] version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class T, class Bop, class Uop>
+    requires detail::transform_reducible<T, Bop, Uop, I>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, T init, Bop bop, Uop uop)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        tail - head, n, std::move(init), std::move(bop), std::move(uop), head //
+    );
+  }
+  /**
+   * @brief [iterator,unary,n = 1] version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class T, class Bop, class Uop>
+    requires detail::transform_reducible<T, Bop, Uop, I>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, T init, Bop bop, Uop uop)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        tail - head, 1, std::move(init), std::move(bop), std::move(uop), head //
+    );
+  }
+  /**
+   * @brief [range,binary,chunk] version.
+   */
+  template <std::ranges::random_access_range R, std::random_access_iterator I2, class T, class Bop, class Top>
+    requires std::ranges::sized_range<R> &&
+             detail::transform_reducible<T, Bop, Top, std::ranges::iterator_t<R>, I2>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 R &&range,
+                                 I2 head2,
+                                 std::ranges::range_difference_t<R> n,
+                                 T init,
+                                 Bop bop,
+                                 Top top) LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        std::ranges::distance(range),
+        n,
+        std::move(init),
+        std::move(bop),
+        std::move(top),
+        std::ranges::begin(range),
+        head2 //
+    );
+  }
+  /**
+   * @brief [range,binary,n = 1] version.
+   */
+  template <std::ranges::random_access_range R, std::random_access_iterator I2, class T, class Bop, class Top>
+    requires std::ranges::sized_range<R> &&
+             detail::transform_reducible<T, Bop, Top, std::ranges::iterator_t<R>, I2>
+  LF_STATIC_CALL auto operator()(auto /* unused */, R &&range, I2 head2, T init, Bop bop, Top top)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        std::ranges::distance(range),
+        1,
+        std::move(init),
+        std::move(bop),
+        std::move(top),
+        std::ranges::begin(range),
+        head2 //
+    );
+  }
+  /**
+   * @brief [range,dot-product,chunk] version.
+   */
+  template <std::ranges::random_access_range R, std::random_access_iterator I2, class T>
+    requires std::ranges::sized_range<R> &&
+             detail::transform_reducible<T, std::plus<>, std::multiplies<>, std::ranges::iterator_t<R>, I2>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, I2 head2, std::ranges::range_difference_t<R> n, T init)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        std::ranges::distance(range),
+        n,
+        std::move(init),
+        std::plus<>{},
+        std::multiplies<>{},
+        std::ranges::begin(range),
+        head2 //
+    );
+  }
+  /**
+   * @brief [range,dot-product,n = 1] version.
+   */
+  template <std::ranges::random_access_range R, std::random_access_iterator I2, class T>
+    requires std::ranges::sized_range<R> &&
+             detail::transform_reducible<T, std::plus<>, std::multiplies<>, std::ranges::iterator_t<R>, I2>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, I2 head2, T init) LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        std::ranges::distance(range),
+        1,
+        std::move(init),
+        std::plus<>{},
+        std::multiplies<>{},
+        std::ranges::begin(range),
+        head2 //
+    );
+  }
+  /**
+   * @brief [range,unary,chunk] version.
+   */
+  template <std::ranges::random_access_range R, class T, class Bop, class Uop>
+    requires std::ranges::sized_range<R> &&
+             detail::transform_reducible<T, Bop, Uop, std::ranges::iterator_t<R>>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, std::ranges::range_difference_t<R> n, T init, Bop bop, Uop uop)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        std::ranges::distance(range),
+        n,
+        std::move(init),
+        std::move(bop),
+        std::move(uop),
+        std::ranges::begin(range) //
+    );
+  }
+  /**
+   * @brief [range,unary,n = 1] version.
+   */
+  template <std::ranges::random_access_range R, class T, class Bop, class Uop>
+    requires std::ranges::sized_range<R> &&
+             detail::transform_reducible<T, Bop, Uop, std::ranges::iterator_t<R>>
+  LF_STATIC_CALL auto operator()(auto /* unused */, R &&range, T init, Bop bop, Uop uop)
+      LF_STATIC_CONST->lf::task<T> {
+    co_return co_await lf::just(detail::transform_reduce_root{})(
+        std::ranges::distance(range),
+        1,
+        std::move(init),
+        std::move(bop),
+        std::move(uop),
+        std::ranges::begin(range) //
+    );
+  }
+};
+
+} // namespace impl
+
+// clang-format off
+
+/**
+ * @brief A parallel implementation of `std::transform_reduce`.
+ *
+ * \rst
+ *
+ * Effective call signatures:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I1,
+ *              std::sized_sentinel_for<I1> S1,
+ *              std::random_access_iterator I2,
+ *              class T,
+ *              class Bop,
+ *              class Top
+ *              >
+ *    auto transform_reduce(I1 head1, S1 tail1, I2 head2, std::iter_difference_t<I1> n, T init, Bop bop, Top top) -> T;
+ *
+ *    template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class T, class Bop, class Uop>
+ *    auto transform_reduce(I head, S tail, std::iter_difference_t<I> n, T init, Bop bop, Uop uop) -> T;
+ *
+ * Overloads exist for a random-access range (instead of ``head1`` and ``tail1``), ``n`` can be omitted (which
+ * will set ``n = 1``) and, in the binary form, ``bop`` and ``top`` can be omitted (which computes an inner
+ * product, using ``std::plus<>`` and ``std::multiplies<>``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    double dot = co_await just[transform_reduce](x, y.begin(), 1024, 0.0);
+ *
+ *    double ss = co_await just[transform_reduce](x, 1024, 0.0, std::plus<>{}, [](double v) {
+ *      return v * v;
+ *    });
+ *
+ * \endrst
+ *
+ * This computes the dot product of `x` and `y` then, the sum of squares of `x`, in chunks of ``1024``.
+ *
+ * The binary form reduces `top(head1[i], head2[i])` and the unary form `uop(head[i])` with `bop`, starting
+ * from `init`. The transformation is fused into the leaves of the reduction, no intermediate buffer is
+ * allocated.
+ * The order of the operands is preserved but, the reduction is re-associated hence, `bop` must be
+ * associative. Unlike `lf::fold`, the operators must be regular (not async) functions.
+ *
+ * When reducing to an arithmetic type with ``std::plus`` or ``std::multiplies`` (or to an integral type with
+ * ``std::ranges::min`` or ``std::ranges::max``) each chunk is reduced with several independent accumulators,
+ * so the compiler can vectorize it. These operators are commutative, the accumulators do not preserve the
+ * order of the operands.
+ */
+inline constexpr impl::transform_reduce_overload transform_reduce = {};
+
+// clang-format on
+
+} // namespace lf
+
+#endif /* A2B60D92_AEAB_4C96_B322_208EC97836FA */
@@ -9,6 +9,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include "libfork/core/cancel.hpp"
 #include "libfork/core/co_alloc.hpp"
 #include "libfork/core/control_flow.hpp"
 #include "libfork/core/defer.hpp"
@@ -19,6 +20,7 @@
 #include "libfork/core/invocable.hpp"
 #include "libfork/core/just.hpp"
 #include "libfork/core/macro.hpp"
+#include "libfork/core/on.hpp"
 #include "libfork/core/scheduler.hpp"
 #include "libfork/core/sync_wait.hpp"
 #include "libfork/core/tag.hpp"
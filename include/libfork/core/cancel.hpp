@@ -0,0 +1,87 @@
+#ifndef D4B6A2C1_3F0E_4C57_9B8A_5E21C7D0F6A3
+#define D4B6A2C1_3F0E_4C57_9B8A_5E21C7D0F6A3
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/**
+ * @file cancel.hpp
+ *
+ * @brief Awaitables (in a `lf::task`) for cooperative cancellation of a task tree.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief An empty tag type used to poll the stop flag of a task tree.
+ */
+struct cancelled_type {};
+
+/**
+ * @brief An empty tag type used to request that a task tree stops.
+ */
+struct request_stop_type {};
+
+} // namespace impl
+
+inline namespace core {
+
+/**
+ * @brief Produce an awaitable (in a `lf::task`) that returns `true` if the task tree has been cancelled.
+ *
+ * Every task in a tree (all the descendants of a root task launched via `lf::core::schedule`) shares
+ * a single stop flag. The flag can be set externally via `lf::core::future::request_stop` or internally
+ * via `lf::core::request_stop`. Once set, every plain `lf::fork` without a return address in the tree
+ * becomes a noop. This never suspends the awaiting task.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    inline constexpr auto search = [](auto self, int n) -> lf::task<> {
+ *
+ *      if (co_await lf::cancelled()) {
+ *        co_return; // Answer found elsewhere, no need to search.
+ *      }
+ *
+ *      ...
+ *    };
+ *
+ * \endrst
+ */
+[[nodiscard("co_await this!")]] constexpr auto cancelled() noexcept -> impl::cancelled_type { return {}; }
+
+/**
+ * @brief Produce an awaitable (in a `lf::task`) that cancels the task tree the awaiting task belongs to.
+ *
+ * This never suspends the awaiting task, see `lf::core::cancelled` for the effects of cancellation.
+ *
+ * \rst
+ *
+ * .. warning::
+ *
+ *    After a tree is cancelled, forked children without a return address are not executed. Forks with
+ *    a return address are always executed, as their parent reads the result after the join (algorithms
+ *    like `lf::fold` rely on this). Neither is `lf::call`, `lf::dispatch` with a modifier or `lf::just`
+ *    affected, these are always executed.
+ *
+ * \endrst
+ */
+[[nodiscard("co_await this!")]] constexpr auto request_stop() noexcept -> impl::request_stop_type {
+  return {};
+}
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* D4B6A2C1_3F0E_4C57_9B8A_5E21C7D0F6A3 */
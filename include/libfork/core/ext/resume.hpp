@@ -45,7 +45,12 @@ inline void resume(submit_handle ptr) {
     if (frame->load_steals() == 0) {
       impl::stack *stack = impl::tls::stack();
       LF_ASSERT(stack->empty());
-      *stack = impl::stack{frame->stacklet()};
+      // Only a submission from outside a pool retires this worker's stacklet to the root cache.
+      if (impl::stack::submitted(frame->stacklet())) {
+        stack->adopt(frame->stacklet());
+      } else {
+        *stack = impl::stack{frame->stacklet()};
+      }
     } else {
       LF_ASSERT_NO_ASSUME(impl::tls::stack()->empty());
     }
@@ -277,6 +277,26 @@ struct fork_awaitable : std::suspend_always {
   frame *self;
 };
 
+/**
+ * @brief An awaiter identical to `fork_awaitable` but the fork is elided if the task tree has been cancelled.
+ *
+ * This is only used for children without a return address, if a child has a return address then its
+ * parent will read the result after the join.
+ */
+struct elidable_fork_awaitable : fork_awaitable {
+  /**
+   * @brief Elide the fork (destroying the child) if the task tree has been cancelled.
+   */
+  auto await_ready() noexcept -> bool {
+    if (self->stop_requested()) {
+      LF_LOG("Fork elided, stop requested");
+      child = nullptr;
+      return true;
+    }
+    return false;
+  }
+};
+
 /**
  * @brief An awaiter identical to `fork_awaitable` but with an additional boolean indicating if the child
  * completed synchronously.
@@ -9,18 +9,18 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#include <atomic>      // for atomic_ref, memory_order, atomic_uint16_t
+#include <atomic>      // for atomic_ref, memory_order, atomic_uint16_t, atomic_bool
 #include <coroutine>   // for coroutine_handle
 #include <cstdint>     // for uint16_t
 #include <exception>   // for exception_ptr, operator==, current_exce...
 #include <memory>      // for construct_at
-#include <semaphore>   // for binary_semaphore
 #include <type_traits> // for is_standard_layout_v, is_trivially_dest...
 #include <utility>     // for exchange
 #include <version>     // for __cpp_lib_atomic_ref
 
 #include "libfork/core/defer.hpp"                // for LF_DEFER
 #include "libfork/core/impl/manual_lifetime.hpp" // for manual_lifetime
+#include "libfork/core/impl/notifier.hpp"        // for root_notifier
 #include "libfork/core/impl/stack.hpp"           // for stack
 #include "libfork/core/impl/utility.hpp"         // for non_null, k_u16_max
 #include "libfork/core/macro.hpp"                // for LF_COMPILER_EXCEPTIONS, LF_ASSERT, LF_F...
@@ -62,11 +62,16 @@ class frame {
      */
     frame *m_parent;
     /**
-     * @brief Root tasks store a pointer to a semaphore to notify the caller.
+     * @brief Root tasks store a pointer to a notifier to signal the caller.
      */
-    std::binary_semaphore *m_sem;
+    root_notifier *m_notify;
   };
 
+  /**
+   * @brief The stop flag shared by every frame in this task tree, inherited from the parent.
+   */
+  std::atomic_bool *m_stop = nullptr;
+
   /**
    * @brief  Number of children joined (with offset).
    */
@@ -115,7 +120,7 @@ class frame {
   /**
    * @brief Construct a frame block.
    *
-   * Non-root tasks will need to call ``set_parent(...)``.
+   * Non-root tasks will need to call ``set_parent(...)``, root tasks ``set_root(...)``.
    */
 #ifndef LF_COROUTINE_OFFSET
   frame(std::coroutine_handle<> coro, stack::stacklet *stacklet) noexcept
@@ -128,14 +133,20 @@ class frame {
 #endif
 
   /**
-   * @brief Set the pointer to the parent frame.
+   * @brief Set the pointer to the parent frame and inherit the parent's stop flag.
    */
-  void set_parent(frame *parent) noexcept { m_parent = non_null(parent); }
+  void set_parent(frame *parent) noexcept {
+    m_parent = non_null(parent);
+    m_stop = parent->m_stop;
+  }
 
   /**
-   * @brief Set a root tasks parent.
+   * @brief Set a root tasks parent and the stop flag for the task tree.
    */
-  void set_root_sem(std::binary_semaphore *sem) noexcept { m_sem = non_null(sem); }
+  void set_root(root_notifier *notify, std::atomic_bool *stop) noexcept {
+    m_notify = non_null(notify);
+    m_stop = non_null(stop);
+  }
 
   /**
    * @brief Set the stacklet object to point at a new stacklet.
@@ -154,11 +165,27 @@ class frame {
   [[nodiscard]] auto parent() const noexcept -> frame * { return m_parent; }
 
   /**
-   * @brief Get a pointer to the semaphore for this root frame.
+   * @brief Get a pointer to the notifier for this root frame.
    *
-   * Only valid if this is not a root frame.
+   * Only valid if this is a root frame.
+   */
+  [[nodiscard]] auto notifier() const noexcept -> root_notifier * { return m_notify; }
+
+  /**
+   * @brief Test if a stop has been requested for this task tree.
+   *
+   * Safe to call concurrently, this is only a hint and provides no synchronization.
+   */
+  [[nodiscard]] auto stop_requested() const noexcept -> bool {
+    return non_null(m_stop)->load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Request that every task in this task tree stops.
+   *
+   * Safe to call concurrently.
    */
-  [[nodiscard]] auto semaphore() const noexcept -> std::binary_semaphore * { return m_sem; }
+  void request_stop() const noexcept { non_null(m_stop)->store(true, std::memory_order_relaxed); }
 
   /**
    * @brief Get a pointer to the top of the top of the stack-stack this frame was allocated on.
@@ -0,0 +1,200 @@
+#ifndef C5E81D3B_7A24_4F6E_A9B0_2D4F6E8A1C37
+#define C5E81D3B_7A24_4F6E_A9B0_2D4F6E8A1C37
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>    // for atomic, memory_order_acq_rel, memory_order_acquire
+#include <chrono>    // for time_point
+#include <cstdint>   // for uint32_t
+#include <semaphore> // for binary_semaphore
+#include <utility>   // for forward
+
+#include "libfork/core/impl/utility.hpp" // for immovable, non_null
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_LOG
+
+/**
+ * @file notifier.hpp
+ *
+ * @brief The mechanism by which a root task signals its completion.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief A type-erased callback run (once) when a root task completes.
+ */
+struct root_continuation {
+  /**
+   * @brief Called with a pointer to this continuation, must not throw.
+   */
+  void (*resume)(root_continuation *self) noexcept;
+};
+
+/**
+ * @brief Notified by a root task's final suspend, the caller can either block or attach a continuation.
+ *
+ * The continuation is run on the thread that completed the root task, as such it must not block.
+ *
+ * Waiting spins for a short while before going to sleep on a semaphore (a futex on Linux), the semaphore
+ * is only touched if the waiter actually sleeps hence, the common case of a short task needs no system
+ * calls. At most one thread may wait at a time.
+ */
+class root_notifier : immovable<root_notifier> {
+
+  /**
+   * @brief The number of polls before a waiter sleeps.
+   */
+  static constexpr int k_spin = 1 << 10;
+
+  enum : std::uint32_t {
+    k_pending,
+    k_sleeping,
+    k_ready,
+  };
+
+ public:
+  /**
+   * @brief Signal completion, must be called exactly once.
+   *
+   * The notifier may be destroyed by a waiter as soon as it observes the notification hence, apart
+   * from the wake-up itself this touches nothing after the release (the continuation is not part of
+   * the notifier).
+   */
+  void notify() noexcept {
+
+    root_continuation *then = m_then.exchange(done(), std::memory_order_acq_rel);
+
+    LF_ASSERT(then != done());
+
+    // Waiters are released before the continuation (if any) is run.
+    if (m_flag.exchange(k_ready, std::memory_order_acq_rel) == k_sleeping) {
+      m_sem.release();
+    }
+
+    if (then != nullptr) {
+      LF_LOG("Root notifier runs continuation");
+      then->resume(then);
+    }
+  }
+
+  /**
+   * @brief Wait (__block__) for the notification.
+   */
+  void wait() noexcept {
+    if (!spin()) {
+      sleep([](std::binary_semaphore &sem) {
+        sem.acquire();
+        return true;
+      });
+    }
+  }
+
+  /**
+   * @brief Wait (__block__) for the notification until `deadline`, returns true if notified.
+   */
+  template <typename Clock, typename Duration>
+  [[nodiscard]] auto wait_until(std::chrono::time_point<Clock, Duration> const &deadline) noexcept -> bool {
+    return spin() || sleep([&](std::binary_semaphore &sem) {
+             return sem.try_acquire_until(deadline);
+           });
+  }
+
+  /**
+   * @brief Test if notify has been called.
+   */
+  [[nodiscard]] auto ready() const noexcept -> bool {
+    return m_flag.load(std::memory_order_acquire) == k_ready;
+  }
+
+  /**
+   * @brief Attach a continuation, at most one continuation can be attached.
+   *
+   * Returns false if the notification has already been delivered in which case, the continuation
+   * will never be run and the caller should run it themselves.
+   */
+  [[nodiscard]] auto then(root_continuation *cont) noexcept -> bool {
+
+    root_continuation *expect = nullptr;
+
+    if (m_then.compare_exchange_strong(expect, non_null(cont), std::memory_order_acq_rel)) {
+      return true;
+    }
+
+    LF_ASSERT(expect == done());
+
+    return false;
+  }
+
+  /**
+   * @brief Remove the continuation `cont` that was attached by `then`.
+   *
+   * Returns true if `cont` will never be run, otherwise the notification has already taken the
+   * continuation and it will be (or is being) run. After a successful detach another continuation
+   * may be attached.
+   */
+  [[nodiscard]] auto detach(root_continuation *cont) noexcept -> bool {
+
+    root_continuation *expect = non_null(cont);
+
+    if (m_then.compare_exchange_strong(expect, nullptr, std::memory_order_acq_rel)) {
+      return true;
+    }
+
+    LF_ASSERT(expect == done());
+
+    return false;
+  }
+
+ private:
+  /**
+   * @brief A sentinel marking the notification as delivered.
+   */
+  static auto done() noexcept -> root_continuation * {
+    static constinit root_continuation sentinel{nullptr};
+    return &sentinel;
+  }
+
+  /**
+   * @brief Poll for the notification, returns true if notified.
+   */
+  auto spin() const noexcept -> bool {
+    for (int i = 0; i < k_spin; ++i) {
+      if (m_flag.load(std::memory_order_acquire) == k_ready) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Announce this thread is sleeping then sleep via `fn`, returns true if notified.
+   */
+  template <typename F>
+  auto sleep(F &&fn) noexcept -> bool {
+
+    std::uint32_t expect = k_pending;
+
+    if (!m_flag.compare_exchange_strong(expect, k_sleeping, std::memory_order_acq_rel)) {
+      if (expect == k_ready) {
+        return true;
+      }
+    }
+
+    // A token is released iff the notifier saw `k_sleeping`.
+    return std::forward<F>(fn)(m_sem);
+  }
+
+  std::atomic<std::uint32_t> m_flag = k_pending;
+  std::atomic<root_continuation *> m_then = nullptr;
+  std::binary_semaphore m_sem{0};
+};
+
+} // namespace lf::impl
+
+#endif /* C5E81D3B_7A24_4F6E_A9B0_2D4F6E8A1C37 */
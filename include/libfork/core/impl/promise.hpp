@@ -11,11 +11,13 @@
 
 #include <atomic>      // for atomic_thread_fence, memory_order_acquire
 #include <bit>         // for bit_cast
+#include <concepts>    // for derived_from, same_as
 #include <coroutine>   // for coroutine_handle, noop_coroutine, coroutine_...
 #include <cstddef>     // for size_t
 #include <type_traits> // for true_type, false_type, remove_cvref_t
 #include <utility>     // for forward
 
+#include "libfork/core/cancel.hpp"          // for cancelled_type, request_stop_type
 #include "libfork/core/co_alloc.hpp"        // for co_allocable, co_new_t
 #include "libfork/core/control_flow.hpp"    // for join_type
 #include "libfork/core/exceptions.hpp"      // for stash_exception_in_return
@@ -29,7 +31,7 @@
 #include "libfork/core/impl/return.hpp"     // for return_result
 #include "libfork/core/impl/stack.hpp"      // for stack
 #include "libfork/core/impl/utility.hpp"    // for byte_cast, k_u16_max
-#include "libfork/core/invocable.hpp"       // for return_address_for, ignore_t
+#include "libfork/core/invocable.hpp"       // for return_address_for, ignore_t, discard_t
 #include "libfork/core/just.hpp"            // for just_awaitable, just_wrapped
 #include "libfork/core/macro.hpp"           // for LF_LOG, LF_ASSERT, LF_FORCEINLINE, LF_ASSERT...
 #include "libfork/core/scheduler.hpp"       // for context_switcher
@@ -42,6 +44,24 @@
  * @brief The promise type for all tasks/coroutines.
  */
 
+namespace lf {
+
+inline namespace core {
+
+template <returnable R>
+class future;
+
+} // namespace core
+
+namespace impl {
+
+template <returnable R>
+class future_awaitable;
+
+} // namespace impl
+
+} // namespace lf
+
 namespace lf::impl {
 
 namespace detail {
@@ -196,6 +216,22 @@ struct promise_base : frame {
     return awaitable{std::forward<A>(await), submit_node_t{submit}};
   }
 
+  /**
+   * @brief Suspend (releasing the worker) until `fut` is ready then, return its result.
+   */
+  template <returnable R>
+  auto await_transform(future<R> &fut) {
+    return await_transform(future_awaitable<R>{&fut});
+  }
+
+  /**
+   * @brief Suspend (releasing the worker) until `fut` is ready then, return its result.
+   */
+  template <returnable R>
+  auto await_transform(future<R> &&fut) {
+    return await_transform(future_awaitable<R>{&fut});
+  }
+
   // -------------------------------------------------------------- //
 
   /**
@@ -205,6 +241,23 @@ struct promise_base : frame {
 
   // -------------------------------------------------------------- //
 
+  /**
+   * @brief Poll this task tree's stop flag.
+   */
+  auto await_transform(cancelled_type /*unused*/) const noexcept -> just_wrapped<bool> {
+    return {{}, this->stop_requested()};
+  }
+
+  /**
+   * @brief Cancel this task tree.
+   */
+  auto await_transform(request_stop_type /*unused*/) const noexcept -> just_wrapped<void> {
+    this->request_stop();
+    return {};
+  }
+
+  // -------------------------------------------------------------- //
+
   /**
    * @brief Transform a call packet into a call awaitable.
    */
@@ -229,7 +282,9 @@ struct promise_base : frame {
     }
 
     if constexpr (Tag == tag::fork) {
-      if /*  */ constexpr (std::same_as<Mod, modifier::none>) {
+      if /*  */ constexpr (std::same_as<Mod, modifier::none> && std::derived_from<I, discard_t>) {
+        return elidable_fork_awaitable{{{}, std::move(awaitable), this}};
+      } else if constexpr (std::same_as<Mod, modifier::none>) {
         return fork_awaitable{{}, std::move(awaitable), this};
       } else if constexpr (std::same_as<Mod, modifier::sync>) {
         return sync_fork_awaitable<throwing, unknown>{{{}, std::move(awaitable), this}, this->load_steals()};
@@ -334,9 +389,10 @@ struct promise : promise_base, return_result<R, I> {
 
       if constexpr (Tag == tag::root) {
 
-        LF_LOG("Root task at final suspend, releases semaphore and yields");
+        LF_LOG("Root task at final suspend, notifies and yields");
 
-        child.promise().semaphore()->release();
+        // The frame holds a reference to the shared state hence, the notifier outlives this call.
+        child.promise().notifier()->notify();
         child.destroy();
 
         // A root task is always the first on a stack, now it has been completed the stack is empty.
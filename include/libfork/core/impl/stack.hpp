@@ -10,6 +10,8 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include <algorithm>   // for max
+#include <array>       // for array
+#include <atomic>      // for atomic_flag, memory_order_acquire, memory_order_release
 #include <bit>         // for has_single_bit
 #include <cstddef>     // for size_t, byte, nullptr_t
 #include <cstdlib>     // for free, malloc
@@ -37,6 +39,15 @@
 
 static_assert(LF_FIBRE_INIT_SIZE > 0, "Stacks must have a positive size");
 
+#ifndef LF_FIBRE_CACHE_SIZE
+  /**
+   * @brief The maximum number of empty root stacklets kept (process-wide) for reuse.
+   *
+   * Set to zero to disable the cache.
+   */
+  #define LF_FIBRE_CACHE_SIZE 64
+#endif
+
 namespace lf::impl {
 
 /**
@@ -163,6 +174,8 @@ class stack {
       next->m_prev = prev;
       next->m_next = nullptr;
 
+      next->m_submitted = false;
+
       return next;
     }
 
@@ -173,6 +186,106 @@ class stack {
       return stacklet::next_stacklet(LF_FIBRE_INIT_SIZE, nullptr);
     }
 
+    /**
+     * @brief Allocate an initial stacklet, reusing one from the root cache if possible.
+     */
+    [[nodiscard]] static auto pop_root() -> stacklet * {
+      if (stacklet *cached = root_cache::get().pop()) {
+        return cached;
+      }
+      return next_stacklet();
+    }
+
+    /**
+     * @brief Free an empty root stacklet, it may be cached for reuse by `pop_root()`.
+     */
+    static void push_root(stacklet *root) noexcept {
+
+      LF_ASSERT(root && !root->m_prev && !root->m_next);
+
+      // Guard against caching oversized stacklets.
+      constexpr std::size_t max_capacity =
+          8 * (impl::round_up_to_page_size(LF_FIBRE_INIT_SIZE + sizeof(stacklet)) - sizeof(stacklet));
+
+      if (!root->empty() || root->capacity() > max_capacity || !root_cache::get().push(root)) {
+        std::free(root); // NOLINT
+      }
+    }
+
+    /**
+     * @brief A process-wide cache of empty root stacklets.
+     *
+     * A root task's stacklet migrates from the thread that submits it to the worker that runs it, at
+     * which point the worker's previous (empty) stacklet is retired. Without this cache every
+     * submission from outside a pool would pay for a `malloc`/`free` pair, with it, repeated
+     * submissions reach a steady state that does not allocate.
+     *
+     * Only the submission path touches the cache: the stacks of threads outside a pool and workers
+     * adopting a submitted task. The steal/join paths of the workers never take the lock.
+     */
+    class root_cache {
+     public:
+      /**
+       * @brief The process-wide cache, this is never destroyed.
+       */
+      [[nodiscard]] static auto get() noexcept -> root_cache & {
+        static constinit root_cache cache;
+        return cache;
+      }
+
+      /**
+       * @brief Take a stacklet from the cache, returns `nullptr` if the cache is empty.
+       */
+      [[nodiscard]] auto pop() noexcept -> stacklet * {
+
+        stacklet *out = nullptr;
+
+        if constexpr (LF_FIBRE_CACHE_SIZE > 0) {
+          lock();
+          if (m_size > 0) {
+            out = m_slots[--m_size];
+          }
+          unlock();
+        }
+
+        return out;
+      }
+
+      /**
+       * @brief Add an empty root stacklet to the cache, returns false if the cache is full.
+       */
+      [[nodiscard]] auto push(stacklet *root) noexcept -> bool {
+
+        bool pushed = false;
+
+        if constexpr (LF_FIBRE_CACHE_SIZE > 0) {
+          lock();
+          if (m_size < m_slots.size()) {
+            m_slots[m_size++] = root;
+            pushed = true;
+          }
+          unlock();
+        }
+
+        return pushed;
+      }
+
+     private:
+      /**
+       * @brief Spin, the critical sections are a handful of instructions.
+       */
+      void lock() noexcept {
+        while (m_lock.test_and_set(std::memory_order_acquire)) {
+        }
+      }
+
+      void unlock() noexcept { m_lock.clear(std::memory_order_release); }
+
+      std::atomic_flag m_lock;
+      std::size_t m_size = 0;
+      std::array<stacklet *, LF_FIBRE_CACHE_SIZE> m_slots = {};
+    };
+
     /**
      * @brief This stacklet's stack.
      */
@@ -193,6 +306,10 @@ class stack {
      * @brief Doubly linked list (future).
      */
     stacklet *m_next;
+    /**
+     * @brief Set if this was released by a stack using the root cache, cleared when adopted.
+     */
+    bool m_submitted;
   };
 
   // Keep stack aligned.
@@ -202,11 +319,23 @@ class stack {
   static_assert(std::is_trivially_default_constructible_v<stacklet>);
   static_assert(std::is_trivially_destructible_v<stacklet>);
 
+  /**
+   * @brief Tag type to construct a stack whose root stacklets are drawn from, and returned to, the root cache.
+   */
+  struct root_cache_t {};
+
   /**
    * @brief Constructs a stack with a small empty stack.
    */
   stack() : m_fib(stacklet::next_stacklet()) { LF_LOG("Constructing a stack"); }
 
+  /**
+   * @brief Constructs a stack for a thread outside a pool, see `root_cache_t`.
+   */
+  explicit stack(root_cache_t) : m_fib(stacklet::pop_root()), m_root_cache{true} {
+    LF_LOG("Constructing a cached stack");
+  }
+
   /**
    * @brief Construct a new stack object taking ownership of the stack that `frag` is a top-of.
    */
@@ -249,7 +378,11 @@ class stack {
     LF_ASSERT(m_fib);
     LF_ASSERT(!m_fib->m_prev); // Should only be destructed at the root.
     m_fib->set_next(nullptr);  // Free a cached stacklet.
-    std::free(m_fib);          // NOLINT
+    if (m_root_cache) {
+      stacklet::push_root(m_fib);
+    } else {
+      std::free(m_fib); // NOLINT
+    }
   }
 
   /**
@@ -268,9 +401,35 @@ class stack {
   [[nodiscard]] auto release() -> stacklet * {
     LF_LOG("Releasing stack");
     LF_ASSERT(m_fib);
+    if (m_root_cache) {
+      m_fib->m_submitted = true;
+      return std::exchange(m_fib, stacklet::pop_root());
+    }
     return std::exchange(m_fib, stacklet::next_stacklet());
   }
 
+  /**
+   * @brief Test if `frag` was released by a stack using the root cache and has not yet been adopted.
+   */
+  [[nodiscard]] static auto submitted(stacklet const *frag) noexcept -> bool {
+    return non_null(frag)->m_submitted;
+  }
+
+  /**
+   * @brief Continue the stack that `frag` is a top-of, retiring this (empty) stack to the root cache.
+   *
+   * This is used by a worker to adopt a task submitted to it, the submitter drew a replacement for `frag`
+   * from the cache. Requires `submitted(frag)`, other stacklets should be move-assigned.
+   */
+  void adopt(stacklet *frag) noexcept {
+    LF_LOG("Adopting stacklet");
+    LF_ASSERT(empty());
+    LF_ASSERT(frag && frag->is_top() && frag->m_submitted);
+    frag->m_submitted = false;
+    m_fib->set_next(nullptr);
+    stacklet::push_root(std::exchange(m_fib, frag));
+  }
+
   /**
    * @brief Allocate `count` bytes of memory on a stacklet in the bundle.
    *
@@ -349,6 +508,10 @@ class stack {
    * @brief The allocation stacklet.
    */
   stacklet *m_fib;
+  /**
+   * @brief If set then root stacklets are drawn from, and returned to, the root cache.
+   */
+  bool m_root_cache = false;
 };
 
 } // namespace lf::impl
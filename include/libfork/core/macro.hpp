@@ -368,6 +368,23 @@ using std::unreachable;
   #define LF_PRAGMA_UNROLL(n)
 #endif
 
+/**
+ * @brief Non-zero if the compiler supports GCC style vector extensions (and ``__builtin_shufflevector``).
+ *
+ * This can be overridden by defining ``LF_VECTOR_EXTENSIONS`` to ``0`` or ``1``.
+ */
+#ifndef LF_VECTOR_EXTENSIONS
+  #if defined(__has_builtin) && defined(__GNUC__)
+    #if __has_builtin(__builtin_shufflevector)
+      #define LF_VECTOR_EXTENSIONS 1
+    #else
+      #define LF_VECTOR_EXTENSIONS 0
+    #endif
+  #else
+    #define LF_VECTOR_EXTENSIONS 0
+  #endif
+#endif
+
 // NOLINTEND
 
 #endif /* C5DCA647_8269_46C2_B76F_5FA68738AEDA */
@@ -0,0 +1,127 @@
+#ifndef C84C1F3A_5D7E_4B2F_9A61_0E3B7D95F428
+#define C84C1F3A_5D7E_4B2F_9A61_0E3B7D95F428
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <exception>   // for rethrow_exception
+#include <type_traits> // for decay_t, is_void_v
+#include <utility>     // for forward, move
+
+#include "libfork/core/control_flow.hpp" // for call, join
+#include "libfork/core/eventually.hpp"   // for try_eventually
+#include "libfork/core/ext/context.hpp"  // for worker_context
+#include "libfork/core/ext/handles.hpp"  // for submit_handle
+#include "libfork/core/ext/tls.hpp"      // for context
+#include "libfork/core/first_arg.hpp"    // for async_function_object
+#include "libfork/core/invocable.hpp"    // for async_result_t, callable
+#include "libfork/core/just.hpp"         // for just_awaitable
+#include "libfork/core/scheduler.hpp"    // for scheduler, resume_on, context_switcher
+#include "libfork/core/task.hpp"         // for task
+
+/**
+ * @file on.hpp
+ *
+ * @brief Await (in a `lf::task`) an async function running on another scheduler.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief An ``lf::core::context_switcher`` that submits the awaiting task to a scheduler.
+ */
+template <scheduler Sch>
+struct submit_to_awaitable {
+  /**
+   * @brief Always suspend.
+   */
+  static auto await_ready() noexcept -> bool { return false; }
+  /**
+   * @brief Submit the awaiting task to `dest`.
+   */
+  void await_suspend(submit_handle handle) noexcept(noexcept(std::declval<Sch *>()->schedule(handle))) {
+    dest->schedule(handle);
+  }
+  /**
+   * @brief A no-op.
+   */
+  static void await_resume() noexcept {}
+  /**
+   * @brief The scheduler to submit to.
+   */
+  Sch *dest;
+};
+
+/**
+ * @brief Hop to `dest`, call `fun(args...)` then hop back to the worker this started on.
+ */
+inline constexpr auto on_trampoline =
+    []<scheduler Sch, typename F, typename... Args>(auto, Sch *dest, F fun, Args... args)
+    -> task<async_result_t<F, Args...>> {
+  //
+  using result_t = async_result_t<F, Args...>;
+
+  worker_context *home = tls::context();
+
+  // Exceptions must be caught on `dest` such that they are rethrown at home.
+  try_eventually<result_t> out;
+
+  co_await submit_to_awaitable<Sch>{dest};
+
+  co_await lf::call(&out, std::move(fun))(std::move(args)...);
+  co_await lf::join;
+
+  co_await lf::resume_on(home);
+
+  if (out.has_exception()) {
+    std::rethrow_exception(std::move(out).exception());
+  }
+
+  if constexpr (!std::is_void_v<result_t>) {
+    co_return *std::move(out);
+  }
+};
+
+} // namespace impl
+
+inline namespace core {
+
+/**
+ * @brief Produce an awaitable (in a `lf::task`) that calls `fun(args...)` on the scheduler `sch`.
+ *
+ * The awaiting task is suspended (releasing its worker and stack) and submitted to `sch`, where `fun` is
+ * called as a child task. Once that child has joined the task is resumed on the worker it was suspended
+ * on. Awaiting this returns the result of `fun` or rethrows its exception. The callable and arguments
+ * are decay-copied, `sch` must outlive the call. This allows pools to be nested, or work to be handed
+ * between pools, without blocking a worker.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    int x = co_await lf::on(io_pool, fetch, key);
+ *
+ * \endrst
+ */
+template <scheduler Sch, async_function_object F, typename... Args>
+  requires callable<std::decay_t<F>, std::decay_t<Args>...>
+auto on(Sch &sch, F &&fun, Args &&...args)
+    -> impl::just_awaitable<async_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+  return impl::just_awaitable<async_result_t<std::decay_t<F>, std::decay_t<Args>...>>{
+      impl::on_trampoline, &sch, std::forward<F>(fun), std::forward<Args>(args)...};
+}
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* C84C1F3A_5D7E_4B2F_9A61_0E3B7D95F428 */
@@ -9,29 +9,35 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <atomic>      // for atomic_bool, atomic_flag, atomic_size_t, memory_order_relaxed
 #include <bit>         // for bit_cast
+#include <chrono>      // for duration, time_point, steady_clock
+#include <cstddef>     // for size_t
 #include <exception>   // for exception, rethrow_exception
 #include <memory>      // for make_shared, shared_ptr
 #include <optional>    // for optional
-#include <semaphore>   // for binary_semaphore
-#include <type_traits> // for is_trivially_destructible_v
+#include <type_traits> // for is_trivially_destructible_v, type_identity, remove_cvref_t
 #include <utility>     // for forward, exchange
+#include <vector>      // for vector
 
+#include "libfork/core/control_flow.hpp"         // for call, join
 #include "libfork/core/defer.hpp"                // for LF_DEFER
 #include "libfork/core/eventually.hpp"           // for try_eventually
 #include "libfork/core/exceptions.hpp"           // for schedule_in_worker
+#include "libfork/core/ext/context.hpp"          // for worker_context
 #include "libfork/core/ext/handles.hpp"          // for submit_node_t, submit_t
 #include "libfork/core/ext/tls.hpp"              // for has_stack, thread_stack, has_context
 #include "libfork/core/first_arg.hpp"            // for async_function_object
 #include "libfork/core/impl/combinate.hpp"       // for quasi_awaitable, y_combinate
 #include "libfork/core/impl/manual_lifetime.hpp" // for manual_lifetime
+#include "libfork/core/impl/notifier.hpp"        // for root_notifier, root_continuation
 #include "libfork/core/impl/stack.hpp"           // for stack
-#include "libfork/core/impl/utility.hpp"
-#include "libfork/core/invocable.hpp" // for async_result_t, rootable, ignore_t
-#include "libfork/core/macro.hpp"     // for LF_THROW, LF_CLANG_TLS_NOINLINE
-#include "libfork/core/scheduler.hpp" // for scheduler
-#include "libfork/core/tag.hpp"       // for tag, none
-#include "libfork/core/task.hpp"      // for returnable
+#include "libfork/core/impl/utility.hpp"         // for non_null
+#include "libfork/core/invocable.hpp"            // for async_result_t, rootable, callable, ignore_t
+#include "libfork/core/macro.hpp"                // for LF_THROW, LF_CLANG_TLS_NOINLINE
+#include "libfork/core/scheduler.hpp"            // for scheduler
+#include "libfork/core/tag.hpp"                  // for tag, none
+#include "libfork/core/task.hpp"                 // for returnable, task
 
 /**
  * @file sync_wait.hpp
@@ -79,9 +85,13 @@ struct future_shared_state : try_eventually<R> {
    */
   manual_lifetime<submit_node_t> node;
   /**
-   * @brief The root task's notification semaphore.
+   * @brief Notified when the root task completes.
    */
-  std::binary_semaphore sem{0};
+  root_notifier notify;
+  /**
+   * @brief The stop flag shared by every task in the tree.
+   */
+  std::atomic_bool stop = false;
   /**
    * @brief The state of the future.
    */
@@ -94,6 +104,29 @@ struct future_shared_state : try_eventually<R> {
 template <typename R>
 using future_shared_state_ptr = std::shared_ptr<future_shared_state<R>>;
 
+/**
+ * @brief Grants the implementation access to a future's shared state.
+ */
+struct future_access;
+
+/**
+ * @brief The result of calling `F` with the result of a future.
+ */
+template <typename F, typename R>
+struct then_result : std::type_identity<async_result_t<F, R>> {};
+
+/**
+ * @brief The result of calling `F` with the (void) result of a future.
+ */
+template <typename F>
+struct then_result<F, void> : std::type_identity<async_result_t<F>> {};
+
+/**
+ * @brief The result of a continuation `F` attached to a `future<R>`.
+ */
+template <typename F, typename R>
+using then_result_t = typename then_result<F, R>::type;
+
 } // namespace impl
 
 inline namespace core {
@@ -120,6 +153,9 @@ struct empty_future : std::exception {
 
 /**
  * @brief A future is a handle to the result of an asynchronous operation.
+ *
+ * Inside a task a future can be ``co_await`` ed, this suspends the task (releasing its worker) until the
+ * future is ready and then returns its result (or rethrows its exception).
  */
 template <returnable R>
 class future {
@@ -135,6 +171,8 @@ class future {
     requires rootable<F, Args...>
   friend auto schedule(Sch &&sch, F &&fun, Args &&...args) -> future<async_result_t<F, Args...>>;
 
+  friend struct impl::future_access;
+
 // Work-around: https://github.com/llvm/llvm-project/issues/63536
 #if defined(__clang__)
   #if defined(__apple_build_version__)
@@ -174,7 +212,7 @@ class future {
    */
   ~future() noexcept {
     if (valid() && m_heap->status == no_wait) {
-      m_heap->sem.acquire();
+      m_heap->notify.wait();
     }
   }
   /**
@@ -187,6 +225,36 @@ class future {
    * Following this operation the destructor is guaranteed to not block.
    */
   void detach() noexcept { std::exchange(m_heap, nullptr); }
+  /**
+   * @brief Request that the task tree (rooted at the task this future is bound to) stops early.
+   *
+   * This does not block. Subsequent forks in the task tree are elided and tasks polling
+   * `lf::core::cancelled` will observe the request. The result of a cancelled task tree
+   * is whatever the root task returns. If the future has no shared state then a
+   * `lf::core::broken_future` will be thrown.
+   */
+  void request_stop() {
+
+    if (!valid()) {
+      LF_THROW(broken_future{});
+    }
+
+    m_heap->stop.store(true, std::memory_order_relaxed);
+  }
+  /**
+   * @brief Test if a stop has been requested for the task tree bound to this future.
+   *
+   * This could have been requested via `request_stop` or from inside the task tree.
+   */
+  [[nodiscard]] auto stop_requested() const noexcept -> bool {
+    return valid() && m_heap->stop.load(std::memory_order_relaxed);
+  }
+  /**
+   * @brief Test (without blocking) if the result is ready.
+   */
+  [[nodiscard]] auto is_ready() const noexcept -> bool {
+    return valid() && (m_heap->status != no_wait || m_heap->notify.ready());
+  }
   /**
    * @brief Wait (__block__) for the future to complete.
    */
@@ -197,9 +265,54 @@ class future {
     }
 
     if (m_heap->status == no_wait) {
-      m_heap->sem.acquire();
+      m_heap->notify.wait();
+      m_heap->status = ready;
+    }
+  }
+  /**
+   * @brief Attach a continuation, `fun` is scheduled on `sch` as a new root task once this future is ready.
+   *
+   * No thread blocks waiting for the result: the continuation is submitted to `sch` by the thread that
+   * completes this future's task. `fun` is called with the result of this future (or no arguments if the
+   * result is `void`), if this future completed with an exception then `fun` is not called and the
+   * exception is propagated to the returned future. This future is consumed, `sch` must outlive the
+   * continuation.
+   *
+   * This must not be called by a worker thread. If submitting the continuation to `sch` throws from
+   * a worker thread then the program is terminated.
+   */
+  template <scheduler Sch, async_function_object F>
+  auto then(Sch &sch, F &&fun) && -> future<impl::then_result_t<std::remove_cvref_t<F>, R>>;
+  /**
+   * @brief Wait (__block__) for the future to complete or for `deadline` to pass.
+   *
+   * Returns true if the future has completed. If the future has no shared state then a
+   * `lf::core::broken_future` will be thrown.
+   */
+  template <typename Clock, typename Duration>
+  [[nodiscard]] auto wait_until(std::chrono::time_point<Clock, Duration> const &deadline) -> bool {
+
+    if (!valid()) {
+      LF_THROW(broken_future{});
+    }
+
+    if (m_heap->status == no_wait) {
+      if (!m_heap->notify.wait_until(deadline)) {
+        return false;
+      }
       m_heap->status = ready;
     }
+
+    return true;
+  }
+  /**
+   * @brief Wait (__block__) for the future to complete or for `timeout` to elapse.
+   *
+   * Equivalent to ``wait_until(std::chrono::steady_clock::now() + timeout)``.
+   */
+  template <typename Rep, typename Period>
+  [[nodiscard]] auto wait_for(std::chrono::duration<Rep, Period> const &timeout) -> bool {
+    return wait_until(std::chrono::steady_clock::now() + timeout);
   }
   /**
    * @brief Wait (__block__) for the result to complete and then return it.
@@ -237,51 +350,106 @@ struct schedule_in_worker : std::exception {
   auto what() const noexcept -> char const * override { return "schedule(...) called from a worker thread!"; }
 };
 
+} // namespace core
+
+namespace impl {
+
 /**
- * @brief Schedule execution of `fun` on `sch` and return a `lf::core::future` to the result.
+ * @brief Build a root task on this (non-worker) thread, bound to `state`, and pass it to `submit`.
  *
- * This will build a task from `fun` and dispatch it to `sch` via its `schedule` method. If `schedule` is
- * called by a worker thread (which are never allowed to block) then `lf::core::schedule_in_worker` will be
- * thrown.
+ * The state is held by the root task via (a copy of) `state` which may be an owning or a raw pointer.
+ * `submit` is called with a pointer to the root's submit node, if `submit` throws then the task is
+ * destroyed otherwise, ownership of the task is transferred to `submit`.
  */
-template <scheduler Sch, async_function_object F, class... Args>
+template <typename P, typename Submit, async_function_object F, class... Args>
   requires rootable<F, Args...>
-LF_CLANG_TLS_NOINLINE auto
-schedule(Sch &&sch, F &&fun, Args &&...args) -> future<async_result_t<F, Args...>> {
+LF_CLANG_TLS_NOINLINE void launch_root(P const &state, Submit &&submit, F &&fun, Args &&...args) {
   //
-  if (impl::tls::has_stack || impl::tls::has_context) {
+  if (tls::has_stack || tls::has_context) {
     LF_THROW(schedule_in_worker{});
   }
 
-  // Initialize the non-worker's stack.
-  impl::tls::thread_stack.construct();
-  impl::tls::has_stack = true;
+  // Initialize the non-worker's stack, the root's stacklet will migrate to a worker.
+  tls::thread_stack.construct(stack::root_cache_t{});
+  tls::has_stack = true;
 
   // Clean up the stack on exit.
   LF_DEFER {
-    impl::tls::thread_stack.destroy();
-    impl::tls::has_stack = false;
+    tls::thread_stack.destroy();
+    tls::has_stack = false;
   };
 
-  auto share_state = std::make_shared<impl::future_shared_state<async_result_t<F, Args...>>>();
-
   // Build a combinator, copies heap shared_ptr.
-  impl::y_combinate combinator = combinate<tag::root, modifier::none>(share_state, std::forward<F>(fun));
+  y_combinate combinator = combinate<tag::root, modifier::none>(state, std::forward<F>(fun));
   // This allocates a coroutine on this threads stack.
-  impl::quasi_awaitable await = std::move(combinator)(std::forward<Args>(args)...);
-  // Set the root semaphore.
-  await->set_root_sem(&share_state->sem);
+  quasi_awaitable await = std::move(combinator)(std::forward<Args>(args)...);
+  // Set the root notifier and stop flag.
+  await->set_root(&state->notify, &state->stop);
 
   // If this throws then `await` will clean up the coroutine.
-  impl::ignore_t{} = impl::tls::thread_stack->release();
+  ignore_t{} = tls::thread_stack->release();
 
-  // We will pass a pointer to this to .schedule()
-  share_state->node.construct(std::bit_cast<impl::submit_t *>(await.get()));
+  // We will pass a pointer to this to `submit`.
+  state->node.construct(std::bit_cast<submit_t *>(await.get()));
 
-  // Schedule upholds the strong exception guarantee hence, if it throws `await` cleans up.
-  std::forward<Sch>(sch).schedule(share_state->node.data());
+  // Submit upholds the strong exception guarantee hence, if it throws `await` cleans up.
+  std::forward<Submit>(submit)(state->node.data());
   // If -^ didn't throw then we release ownership of the coroutine, it will be cleaned up by the worker.
-  impl::ignore_t{} = await.release();
+  ignore_t{} = await.release();
+}
+
+/**
+ * @brief Implementation of `lf::core::sync_wait`, the shared state lives on this thread's stack.
+ */
+template <typename State, scheduler Sch, async_function_object F, class... Args>
+auto sync_wait_on_stack(Sch &&sch, F &&fun, Args &&...args) -> async_result_t<F, Args...> {
+
+  // The shared state never escapes this function hence, it can live on this thread's stack.
+  State state;
+
+  launch_root(
+      &state,
+      [&](submit_handle node) {
+        std::forward<Sch>(sch).schedule(node);
+      },
+      std::forward<F>(fun),
+      std::forward<Args>(args)...);
+
+  state.notify.wait();
+
+  if (state.has_exception()) {
+    std::rethrow_exception(std::move(state).exception());
+  }
+
+  if constexpr (!std::is_void_v<async_result_t<F, Args...>>) {
+    return *std::move(state);
+  }
+}
+
+} // namespace impl
+
+inline namespace core {
+
+/**
+ * @brief Schedule execution of `fun` on `sch` and return a `lf::core::future` to the result.
+ *
+ * This will build a task from `fun` and dispatch it to `sch` via its `schedule` method. If `schedule` is
+ * called by a worker thread (which are never allowed to block) then `lf::core::schedule_in_worker` will be
+ * thrown.
+ */
+template <scheduler Sch, async_function_object F, class... Args>
+  requires rootable<F, Args...>
+auto schedule(Sch &&sch, F &&fun, Args &&...args) -> future<async_result_t<F, Args...>> {
+
+  auto share_state = std::make_shared<impl::future_shared_state<async_result_t<F, Args...>>>();
+
+  impl::launch_root(
+      share_state,
+      [&](submit_handle node) {
+        std::forward<Sch>(sch).schedule(node);
+      },
+      std::forward<F>(fun),
+      std::forward<Args>(args)...);
 
   return future<async_result_t<F, Args...>>{std::move(share_state)}; // Shared state ownership transferred.
 }
@@ -293,12 +461,24 @@ schedule(Sch &&sch, F &&fun, Args &&...args) -> future<async_result_t<F, Args...
  * is expected to make a call from `main` into a scheduler/runtime by scheduling a single root-task with this
  * function.
  *
- * This makes the appropriate call to `lf::core::schedule` and calls `get` on the returned `lf::core::future`.
+ * This is equivalent to calling `get` on the `lf::core::future` returned by `lf::core::schedule` but, the
+ * shared state lives on the caller's stack hence, this does not allocate (unless `fun` is an extern
+ * function).
  */
 template <scheduler Sch, async_function_object F, class... Args>
   requires rootable<F, Args...>
 auto sync_wait(Sch &&sch, F &&fun, Args &&...args) -> async_result_t<F, Args...> {
-  return schedule(std::forward<Sch>(sch), std::forward<F>(fun), std::forward<Args>(args)...).get();
+
+  using result_t = async_result_t<F, Args...>;
+  using state_t = impl::future_shared_state<result_t>;
+
+  if constexpr (!async_tag_invocable<state_t *, tag::root, std::decay_t<F>, Args...>) {
+    // Extern functions are only instantiated for a heap allocated shared state.
+    return schedule(std::forward<Sch>(sch), std::forward<F>(fun), std::forward<Args>(args)...).get();
+  } else {
+    return impl::sync_wait_on_stack<state_t>(
+        std::forward<Sch>(sch), std::forward<F>(fun), std::forward<Args>(args)...);
+  }
 }
 
 /**
@@ -318,6 +498,372 @@ auto detach(Sch &&sch, F &&fun, Args &&...args) -> void {
 
 } // namespace core
 
+namespace impl {
+
+/**
+ * @brief Grants the implementation access to a future's shared state.
+ */
+struct future_access {
+  /**
+   * @brief Get a reference to the shared state pointer of `fut`.
+   */
+  template <returnable R>
+  static auto state(future<R> &fut) noexcept -> future_shared_state_ptr<R> & {
+    return fut.m_heap;
+  }
+  /**
+   * @brief Make a future bound to `state`.
+   */
+  template <returnable R>
+  static auto make(future_shared_state_ptr<R> &&state) noexcept -> future<R> {
+    return future<R>{std::move(state)};
+  }
+};
+
+/**
+ * @brief An ``lf::core::context_switcher`` that suspends a task until a future is ready.
+ *
+ * The task is rescheduled, on the worker it suspended on, by the thread that completes the future's
+ * task. Awaiting this returns the result of the future or rethrows its exception.
+ */
+template <returnable R>
+class future_awaitable : root_continuation {
+
+  static void wake(root_continuation *self) noexcept {
+    auto *await = static_cast<future_awaitable *>(self);
+    non_null(await->m_context)->schedule(await->m_handle);
+  }
+
+ public:
+  /**
+   * @brief Bind to `fut`, which must outlive the awaitable.
+   */
+  explicit future_awaitable(future<R> *fut) noexcept : root_continuation{&wake}, m_future{non_null(fut)} {}
+
+  /**
+   * @brief Don't suspend if the future is ready, throws if the future has no shared state.
+   */
+  auto await_ready() const -> bool {
+
+    if (!m_future->valid()) {
+      LF_THROW(broken_future{});
+    }
+
+    return m_future->is_ready();
+  }
+
+  /**
+   * @brief Attach this as the continuation of the future's task.
+   */
+  void await_suspend(submit_handle handle) noexcept {
+
+    m_handle = handle;
+    m_context = tls::context();
+
+    // If the future's task has completed in the meantime then no one will run the continuation.
+    if (!future_access::state(*m_future)->notify.then(this)) {
+      m_context->schedule(handle);
+    }
+  }
+
+  /**
+   * @brief Return the result of the future or rethrow its exception.
+   */
+  auto await_resume() -> R { return m_future->get(); }
+
+ private:
+  future<R> *m_future;
+  submit_handle m_handle = nullptr;
+  worker_context *m_context = nullptr;
+};
+
+/**
+ * @brief The shared state of a future returned by `future::then`, also the continuation of the previous.
+ */
+template <returnable R, scheduler Sch>
+struct then_shared_state : future_shared_state<R>, root_continuation {
+  /**
+   * @brief Submit the continuation's root task to `sch`.
+   */
+  explicit then_shared_state(Sch *target) noexcept
+      : root_continuation{[](root_continuation *self) noexcept {
+          auto &next = static_cast<then_shared_state &>(*self);
+          next.sch->schedule(next.node.data());
+        }},
+        sch{target} {}
+
+  /**
+   * @brief The scheduler the continuation will be submitted to.
+   */
+  Sch *sch;
+};
+
+/**
+ * @brief The root task of a continuation, forwards the previous future's result to `fun`.
+ */
+inline constexpr auto then_trampoline =
+    []<returnable R, typename F>(auto, future<R> prev, F fun) -> task<then_result_t<F, R>> {
+  //
+  using result_t = then_result_t<F, R>;
+
+  // If the previous task threw then `get` rethrows and `fun` is never called.
+
+  if constexpr (std::is_void_v<result_t>) {
+    if constexpr (std::is_void_v<R>) {
+      prev.get();
+      co_await lf::call(std::move(fun))();
+    } else {
+      co_await lf::call(std::move(fun))(prev.get());
+    }
+    co_await lf::join;
+  } else {
+    eventually<result_t> out;
+    if constexpr (std::is_void_v<R>) {
+      prev.get();
+      co_await lf::call(&out, std::move(fun))();
+    } else {
+      co_await lf::call(&out, std::move(fun))(prev.get());
+    }
+    co_await lf::join;
+    co_return *std::move(out);
+  }
+};
+
+} // namespace impl
+
+inline namespace core {
+
+template <returnable R>
+template <scheduler Sch, async_function_object F>
+auto future<R>::then(Sch &sch, F &&fun) && -> future<impl::then_result_t<std::remove_cvref_t<F>, R>> {
+
+  using result_t = impl::then_result_t<std::remove_cvref_t<F>, R>;
+  using state_t = impl::then_shared_state<result_t, std::remove_cvref_t<Sch>>;
+
+  if (!valid()) {
+    LF_THROW(broken_future{});
+  }
+
+  auto state = std::make_shared<state_t>(&sch);
+
+  // The previous shared state is kept alive by the continuation's root task.
+  impl::root_notifier *prev = &m_heap->notify;
+
+  impl::launch_root(
+      impl::future_shared_state_ptr<result_t>{state},
+      [&](submit_handle node) {
+        // If the previous task has already completed then no one will run the continuation.
+        if (prev->ready() || !prev->then(state.get())) {
+          sch.schedule(node);
+        }
+      },
+      impl::then_trampoline,
+      std::move(*this),
+      std::forward<F>(fun));
+
+  return impl::future_access::make(impl::future_shared_state_ptr<result_t>{std::move(state)});
+}
+
+/**
+ * @brief The result of `lf::core::when_any`.
+ */
+template <returnable R>
+struct when_any_result {
+  /**
+   * @brief The index of the first future to complete.
+   */
+  std::size_t index;
+  /**
+   * @brief The input futures, in their original order.
+   */
+  std::vector<future<R>> futures;
+};
+
+} // namespace core
+
+namespace impl {
+
+/**
+ * @brief The shared state of a `when_all`/`when_any` future, notified by its inputs' root tasks.
+ *
+ * The state owns a reference to itself until every input has completed or, for `when_any`, has had its
+ * continuation detached.
+ */
+template <returnable R, returnable V, bool Any>
+struct when_shared_state : future_shared_state<V> {
+
+  /**
+   * @brief A continuation attached to one of the inputs.
+   */
+  struct waiter : root_continuation {
+    when_shared_state *owner;
+    std::size_t index;
+  };
+
+  static void resume(root_continuation *self) noexcept {
+
+    auto *wait = static_cast<waiter *>(self);
+    auto *owner = wait->owner;
+
+    if constexpr (Any) {
+      if (!owner->won.test_and_set(std::memory_order_acq_rel)) {
+        owner->first = wait->index;
+        owner->release();
+      }
+    }
+
+    owner->retire(1);
+  }
+
+  /**
+   * @brief Count `num` inputs as done, the last drops the self-reference.
+   */
+  void retire(std::size_t num) noexcept {
+    if (num > 0 && pending.fetch_sub(num, std::memory_order_acq_rel) == num) {
+
+      // Drop the self-reference after this call, may destroy `this`.
+      std::shared_ptr keep = std::move(self);
+
+      if constexpr (!Any) {
+        complete(std::move(futures));
+      }
+    }
+  }
+
+  /**
+   * @brief Called by the first input to complete and by `make` once every waiter is attached.
+   *
+   * The second call detaches the waiters from the losing inputs, such that they can be awaited
+   * again, and then completes the `when_any` future. Must be called while an input is pending or
+   * while `make` holds a reference.
+   */
+  void release() noexcept
+    requires Any
+  {
+    if (gate.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+
+    std::size_t detached = 0;
+
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+      // Fails if the input is completing concurrently, its continuation will then retire itself.
+      if (future_access::state(futures[i])->notify.detach(&waiters[i])) {
+        ++detached;
+      }
+    }
+
+    complete(when_any_result<R>{first, std::move(futures)});
+
+    retire(detached);
+  }
+
+  /**
+   * @brief Set the result and notify.
+   */
+  template <typename U>
+  void complete(U &&result) noexcept {
+    static_cast<future_shared_state<V> &>(*this) = std::forward<U>(result);
+    this->notify.notify();
+  }
+
+  /**
+   * @brief Take ownership of the inputs and attach a continuation to each.
+   */
+  static auto make(std::vector<future<R>> &&futures) -> future<V> {
+
+    for (auto &&fut : futures) {
+      if (!fut.valid()) {
+        LF_THROW(broken_future{});
+      }
+    }
+
+    auto state = std::make_shared<when_shared_state>();
+
+    state->futures = std::move(futures);
+    state->waiters.resize(state->futures.size());
+    state->pending.store(state->futures.size(), std::memory_order_relaxed);
+
+    if (state->futures.empty()) {
+      if constexpr (Any) {
+        state->complete(when_any_result<R>{0, {}});
+      } else {
+        state->complete(std::vector<future<R>>{});
+      }
+    } else {
+
+      state->self = state;
+
+      // Copy, as the vector of futures may be moved-from once the last waiter resumes.
+      std::vector<root_notifier *> inputs;
+
+      inputs.reserve(state->futures.size());
+
+      for (auto &&fut : state->futures) {
+        inputs.push_back(&future_access::state(fut)->notify);
+      }
+
+      for (std::size_t i = 0; i < inputs.size(); ++i) {
+
+        waiter *wait = &state->waiters[i];
+
+        *wait = {{&resume}, state.get(), i};
+
+        if (!inputs[i]->then(wait)) {
+          resume(wait);
+        }
+      }
+
+      if constexpr (Any) {
+        state->release();
+      }
+    }
+
+    return future_access::make(future_shared_state_ptr<V>{std::move(state)});
+  }
+
+  std::vector<future<R>> futures;
+  std::vector<waiter> waiters;
+  std::atomic_size_t pending;
+  std::atomic_flag won = ATOMIC_FLAG_INIT;
+  std::atomic_size_t gate = 2;
+  std::size_t first = 0;
+  std::shared_ptr<when_shared_state> self;
+};
+
+} // namespace impl
+
+inline namespace core {
+
+/**
+ * @brief Produce a future that completes once all of `futures` have completed.
+ *
+ * No thread blocks: the result is set by the thread that completes the last input. The returned
+ * future's result is the input futures (in order) each of which is ready. If `futures` is empty the
+ * returned future is immediately ready. If any of the futures has no shared state then a
+ * `lf::core::broken_future` will be thrown.
+ */
+template <returnable R>
+auto when_all(std::vector<future<R>> futures) -> future<std::vector<future<R>>> {
+  return impl::when_shared_state<R, std::vector<future<R>>, false>::make(std::move(futures));
+}
+
+/**
+ * @brief Produce a future that completes once any of `futures` has completed.
+ *
+ * No thread blocks: the result is set by the thread that completes the first input. The returned
+ * future's result is the index of the first input to complete and the input futures (in order), the
+ * inputs that have not completed are detached and can be awaited (or continued) as usual. If `futures`
+ * is empty the returned future is immediately ready with an index of zero. If any of the futures has no
+ * shared state then a `lf::core::broken_future` will be thrown.
+ */
+template <returnable R>
+auto when_any(std::vector<future<R>> futures) -> future<when_any_result<R>> {
+  return impl::when_shared_state<R, when_any_result<R>, true>::make(std::move(futures));
+}
+
+} // namespace core
+
 } // namespace lf
 
 #endif /* AE259086_6D4B_433D_8EEB_A1E8DC6A5F7A */
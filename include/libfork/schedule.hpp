@@ -9,14 +9,21 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include "libfork/schedule/blocking.hpp"
 #include "libfork/schedule/busy_pool.hpp"
+#include "libfork/schedule/channel.hpp"
+#include "libfork/schedule/completion.hpp"
+#include "libfork/schedule/io.hpp"
 #include "libfork/schedule/lazy_pool.hpp"
+#include "libfork/schedule/sync.hpp"
+#include "libfork/schedule/timer.hpp"
 #include "libfork/schedule/unit_pool.hpp"
 
 #include "libfork/schedule/ext/event_count.hpp"
 #include "libfork/schedule/ext/numa.hpp"
 #include "libfork/schedule/ext/random.hpp"
 
+#include "libfork/schedule/impl/idle.hpp"
 #include "libfork/schedule/impl/numa_context.hpp"
 
 /**
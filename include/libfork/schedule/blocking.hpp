@@ -0,0 +1,328 @@
+#ifndef F7C2B8E1_0D4A_4B93_9E56_3A1D8F6C2E07
+#define F7C2B8E1_0D4A_4B93_9E56_3A1D8F6C2E07
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <chrono>             // for seconds
+#include <concepts>           // for invocable
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t
+#include <exception>          // for rethrow_exception
+#include <memory>             // for shared_ptr, make_shared
+#include <mutex>              // for mutex, unique_lock, lock_guard
+#include <thread>             // for thread
+#include <tuple>              // for tuple, apply
+#include <type_traits>        // for decay_t, invoke_result_t, is_void_v
+#include <utility>            // for move, forward
+
+#include "libfork/core/defer.hpp"                // for LF_DEFER
+#include "libfork/core/eventually.hpp"           // for try_eventually
+#include "libfork/core/ext/context.hpp"          // for worker_context
+#include "libfork/core/ext/handles.hpp"          // for submit_handle
+#include "libfork/core/ext/tls.hpp"              // for context
+#include "libfork/core/impl/manual_lifetime.hpp" // for manual_lifetime
+#include "libfork/core/impl/utility.hpp"         // for immovable, non_null
+#include "libfork/core/macro.hpp"                // for LF_TRY, LF_CATCH_ALL, LF_LOG
+#include "libfork/core/scheduler.hpp"            // for context_switcher
+#include "libfork/core/task.hpp"                 // for returnable
+
+/**
+ * @file blocking.hpp
+ *
+ * @brief Offload blocking calls from a task to an elastic pool of threads.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief A type erased job for the blocking pool, lives in the suspended task's frame.
+ */
+struct blocking_job {
+  /**
+   * @brief Run the job then reschedule the task, must not throw.
+   */
+  void (*run)(blocking_job *self) noexcept;
+  /**
+   * @brief The suspended task.
+   */
+  submit_handle handle;
+  /**
+   * @brief The worker the task will be resumed on.
+   */
+  worker_context *context;
+  /**
+   * @brief The next job in the pool's queue.
+   */
+  blocking_job *next;
+};
+
+/**
+ * @brief An elastic pool of threads for running blocking calls.
+ *
+ * A new thread is started whenever a job is submitted and there are more queued jobs than idle
+ * threads, idle threads exit after `k_keep_alive` without a job.
+ */
+class blocking_pool : immovable<blocking_pool> {
+
+  static constexpr auto k_keep_alive = std::chrono::seconds{1};
+
+  /**
+   * @brief State shared with the (detached) threads such that it outlives them.
+   */
+  struct state {
+    std::mutex mutex;
+    std::condition_variable work;
+    std::condition_variable exit;
+    blocking_job *head = nullptr;
+    blocking_job *tail = nullptr;
+    std::size_t queued = 0;
+    std::size_t idle = 0;
+    std::size_t threads = 0;
+    bool stop = false;
+  };
+
+  static void work(std::shared_ptr<state> const &shared) noexcept {
+
+    std::unique_lock lock{shared->mutex};
+
+    for (;;) {
+      if (blocking_job *job = shared->head) {
+
+        shared->head = job->next;
+        shared->tail = shared->head ? shared->tail : nullptr;
+        shared->queued -= 1;
+
+        lock.unlock();
+        LF_LOG("Blocking thread runs job");
+        job->run(job);
+        lock.lock();
+        continue;
+      }
+
+      if (shared->stop) {
+        break;
+      }
+
+      shared->idle += 1;
+      bool woken = shared->work.wait_for(lock, k_keep_alive, [&] {
+        return shared->head != nullptr || shared->stop;
+      });
+      shared->idle -= 1;
+
+      if (!woken) {
+        break;
+      }
+    }
+
+    shared->threads -= 1;
+    shared->exit.notify_all();
+  }
+
+ public:
+  /**
+   * @brief Submit a job, this starts a new thread if there are no idle threads to run it.
+   *
+   * This gives the strong exception guarantee, if a thread cannot be started then it throws.
+   */
+  void submit(blocking_job *job) {
+
+    non_null(job)->next = nullptr;
+
+    std::lock_guard lock{m_shared->mutex};
+
+    if (m_shared->queued + 1 > m_shared->idle) {
+      std::thread{[shared = m_shared] {
+        work(shared);
+      }}.detach();
+      m_shared->threads += 1;
+    }
+
+    if (m_shared->tail) {
+      m_shared->tail->next = job;
+    } else {
+      m_shared->head = job;
+    }
+
+    m_shared->tail = job;
+    m_shared->queued += 1;
+
+    m_shared->work.notify_one();
+  }
+
+  /**
+   * @brief Get the number of threads currently in the pool.
+   */
+  [[nodiscard]] auto size() const -> std::size_t {
+    std::lock_guard lock{m_shared->mutex};
+    return m_shared->threads;
+  }
+
+  /**
+   * @brief Waits for the queued jobs to complete and all the threads to exit.
+   */
+  ~blocking_pool() noexcept {
+    std::unique_lock lock{m_shared->mutex};
+    m_shared->stop = true;
+    m_shared->work.notify_all();
+    m_shared->exit.wait(lock, [&] {
+      return m_shared->threads == 0;
+    });
+  }
+
+ private:
+  std::shared_ptr<state> m_shared = std::make_shared<state>();
+};
+
+/**
+ * @brief Get the process-wide blocking pool.
+ */
+inline auto blocking_threads() -> blocking_pool & {
+  static blocking_pool instance;
+  return instance;
+}
+
+} // namespace impl
+
+/**
+ * @brief An ``lf::core::context_switcher`` that runs a blocking call on a separate thread.
+ *
+ * The awaiting task is suspended (releasing its worker and stack) while the call runs, then it is
+ * resumed on the worker it was suspended on. Awaiting this returns the result of the call or rethrows
+ * its exception.
+ */
+template <typename F, typename... Args>
+class [[nodiscard("This should be immediately co_awaited")]] blocking_awaitable : impl::blocking_job {
+
+  using result_t = std::invoke_result_t<F, Args...>;
+
+  static_assert(returnable<result_t>, "The result of a blocking call must be returnable!");
+
+  static void invoke(impl::blocking_job *job) noexcept {
+
+    auto *self = static_cast<blocking_awaitable *>(job);
+
+    // clang-format off
+
+    LF_TRY {
+      if constexpr (std::is_void_v<result_t>) {
+        std::apply(std::move(self->m_fun), std::move(self->m_args));
+      } else {
+        *self->m_result = std::apply(std::move(self->m_fun), std::move(self->m_args));
+      }
+    } LF_CATCH_ALL {
+      stash_exception(*self->m_result);
+    }
+
+    // clang-format on
+
+    // Cannot touch `self` after this as the task may have been resumed.
+    impl::non_null(self->context)->schedule(self->handle);
+  }
+
+ public:
+  /**
+   * @brief Store a copy of the callable and its arguments.
+   */
+  template <typename G, typename... Ts>
+  explicit blocking_awaitable(G &&fun, Ts &&...args)
+      : impl::blocking_job{},
+        m_fun(std::forward<G>(fun)),
+        m_args(std::forward<Ts>(args)...) {}
+
+  /**
+   * @brief Move construct, the result storage is only constructed when the task suspends.
+   */
+  blocking_awaitable(blocking_awaitable &&other) noexcept(
+      std::is_nothrow_move_constructible_v<F> && std::is_nothrow_move_constructible_v<std::tuple<Args...>>)
+      : impl::blocking_job{},
+        m_fun(std::move(other.m_fun)),
+        m_args(std::move(other.m_args)) {}
+
+  /**
+   * @brief Always suspend.
+   */
+  static auto await_ready() noexcept -> bool { return false; }
+
+  /**
+   * @brief Submit the call to the blocking pool.
+   */
+  void await_suspend(submit_handle caller) {
+
+    this->run = &blocking_awaitable::invoke;
+    this->handle = caller;
+    this->context = impl::tls::context();
+
+    m_result.construct();
+
+    // clang-format off
+
+    LF_TRY {
+      impl::blocking_threads().submit(this);
+    } LF_CATCH_ALL {
+      m_result.destroy();
+      LF_RETHROW;
+    }
+
+    // clang-format on
+  }
+
+  /**
+   * @brief Return the result of the call or rethrow its exception.
+   */
+  auto await_resume() -> result_t {
+
+    LF_DEFER { m_result.destroy(); };
+
+    if (m_result->has_exception()) {
+      std::rethrow_exception(std::move(*m_result).exception());
+    }
+
+    if constexpr (!std::is_void_v<result_t>) {
+      return *std::move(*m_result);
+    }
+  }
+
+ private:
+  [[no_unique_address]] F m_fun;
+  [[no_unique_address]] std::tuple<Args...> m_args;
+  impl::manual_lifetime<try_eventually<result_t>> m_result;
+};
+
+static_assert(context_switcher<blocking_awaitable<void (*)()>>);
+
+/**
+ * @brief Produce an awaitable (in a `lf::task`) that calls `fun(args...)` on a separate thread.
+ *
+ * This is intended for calls (i.e. third-party synchronous APIs) that would otherwise block a worker.
+ * The callable and arguments are decay-copied (like `std::thread`) and invoked as rvalues on a thread
+ * belonging to an elastic, process-wide, pool. The awaiting task gives up its worker while suspended
+ * and is resumed on the same worker once the call returns.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::string body = co_await lf::blocking(http_get, "https://example.com");
+ *
+ * \endrst
+ */
+template <typename F, typename... Args>
+  requires std::invocable<std::decay_t<F>, std::decay_t<Args>...>
+auto blocking(F &&fun, Args &&...args) -> blocking_awaitable<std::decay_t<F>, std::decay_t<Args>...> {
+  return blocking_awaitable<std::decay_t<F>, std::decay_t<Args>...>{std::forward<F>(fun),
+                                                                    std::forward<Args>(args)...};
+}
+
+} // namespace lf
+
+#endif /* F7C2B8E1_0D4A_4B93_9E56_3A1D8F6C2E07 */
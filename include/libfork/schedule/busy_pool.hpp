@@ -9,25 +9,28 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#include <atomic>  // for atomic_flag, memory_order_acquire, mem...
-#include <cstddef> // for size_t, ptrdiff_t
-#include <latch>   // for latch
-#include <memory>  // for shared_ptr, __shared_ptr_access, make_...
-#include <random>  // for random_device, uniform_int_distribution
-#include <span>    // for span
-#include <thread>  // for thread
-#include <utility> // for move
-#include <vector>  // for vector
+#include <atomic>   // for atomic_flag, memory_order_acquire, mem...
+#include <concepts> // for same_as
+#include <cstddef>  // for size_t, ptrdiff_t
+#include <latch>    // for latch
+#include <memory>   // for shared_ptr, __shared_ptr_access, make_...
+#include <random>   // for random_device, uniform_int_distribution
+#include <span>     // for span
+#include <thread>   // for thread
+#include <utility>  // for move
+#include <vector>   // for vector
 
 #include "libfork/core/defer.hpp"                 // for LF_DEFER
 #include "libfork/core/ext/context.hpp"           // for worker_context, nullary_function_t
 #include "libfork/core/ext/handles.hpp"           // for submit_handle, task_handle
 #include "libfork/core/ext/resume.hpp"            // for resume
 #include "libfork/core/impl/utility.hpp"          // for checked_cast, k_cache_line
+#include "libfork/core/invocable.hpp"            // for async_function_object, rootable, async_result_t
 #include "libfork/core/macro.hpp"                 // for LF_ASSERT, LF_ASSERT_NO_ASSUME, LF_LOG
 #include "libfork/core/scheduler.hpp"             // for scheduler
 #include "libfork/schedule/ext/numa.hpp"          // for numa_strategy, numa_topology
 #include "libfork/schedule/ext/random.hpp"        // for xoshiro, seed
+#include "libfork/schedule/impl/guests.hpp"       // for guest_list, caller_runs
 #include "libfork/schedule/impl/numa_context.hpp" // for numa_context
 
 /**
@@ -63,6 +66,19 @@ struct busy_vars {
    * @brief Signal shutdown.
    */
   alignas(k_cache_line) std::atomic_flag stop;
+  /**
+   * @brief Threads temporarily working for the pool.
+   */
+  guest_list guests;
+
+  /**
+   * @brief Resume `handle` on a guest.
+   */
+  template <typename Handle>
+    requires std::same_as<Handle, task_handle> || std::same_as<Handle, submit_handle>
+  static void active_work(Handle handle) noexcept {
+    resume(handle);
+  }
 };
 
 /**
@@ -193,6 +209,23 @@ class busy_pool {
    */
   void schedule(submit_handle job) { m_worker[m_dist(m_rng)]->schedule(job); }
 
+  /**
+   * @brief Run `fun` to completion with the calling thread temporarily joining the pool, returns the result.
+   *
+   * This is an alternative to ``lf::sync_wait(pool, fun, args...)`` in which the calling thread runs the
+   * root task itself, instead of sleeping while a worker is woken to run it. The pool's workers can steal
+   * from the calling thread until the root task completes, then the thread leaves the pool. The calling
+   * thread never steals from the pool, it only runs the root task's work that is not stolen from it.
+   *
+   * If the thread cannot join the pool (there is a small limit on the number of concurrent callers) this
+   * falls back to ``lf::sync_wait``.
+   */
+  template <async_function_object F, class... Args>
+    requires rootable<F, Args...>
+  auto caller_runs(F &&fun, Args &&...args) -> async_result_t<F, Args...> {
+    return impl::caller_runs(*m_share, *this, std::forward<F>(fun), std::forward<Args>(args)...);
+  }
+
   /**
    * @brief Get a view of the worker's contexts.
    */
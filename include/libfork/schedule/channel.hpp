@@ -0,0 +1,460 @@
+#ifndef B83E5F1A_2C7D_4A96_9D04_6E1B8C3F7A52
+#define B83E5F1A_2C7D_4A96_9D04_6E1B8C3F7A52
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <concepts>    // for movable
+#include <cstddef>     // for size_t
+#include <limits>      // for numeric_limits
+#include <memory>      // for unique_ptr, make_unique
+#include <mutex>       // for lock_guard
+#include <optional>    // for optional, nullopt
+#include <utility>     // for move, exchange
+
+#include "libfork/core/ext/handles.hpp"  // for submit_handle
+#include "libfork/core/ext/tls.hpp"      // for context
+#include "libfork/core/impl/utility.hpp" // for immovable, non_null
+#include "libfork/core/invocable.hpp"    // for ignore_t
+#include "libfork/core/macro.hpp"        // for LF_ASSERT
+#include "libfork/core/scheduler.hpp"    // for context_switcher
+#include "libfork/schedule/sync.hpp"     // for sync_waiter, sync_queue, sync_spinlock, sync_resume_all
+
+/**
+ * @file channel.hpp
+ *
+ * @brief Multi-producer multi-consumer channels between tasks.
+ */
+
+namespace lf {
+
+/**
+ * @brief A multi-producer multi-consumer FIFO channel for passing values between tasks.
+ *
+ * A channel is either bounded, in which case sending to a full channel suspends the sender, or unbounded.
+ * Receiving from an empty channel suspends the receiver. Suspended tasks release their worker and are
+ * resumed on the worker they suspended on. Values are handed directly to a waiting receiver if there is
+ * one. Each value is boxed (allocated) by the sender before the channel's lock is taken, under the lock
+ * only pointers are linked/unlinked and values are moved out by the receiver after the lock is released.
+ *
+ * After ``close()`` sends fail and receivers drain the remaining values, once the channel is empty
+ * receives return ``std::nullopt``.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    while (std::optional<int> val = co_await ch.recv()) {
+ *      consume(*val);
+ *    }
+ *
+ * \endrst
+ */
+template <std::movable T>
+class channel : impl::immovable<channel<T>> {
+
+  /**
+   * @brief A value in flight, the value is moved in before the channel is locked.
+   */
+  struct node {
+    explicit node(T &&val) : value{std::move(val)} {}
+
+    T value;
+    node *next = nullptr;
+  };
+
+  /**
+   * @brief A suspended sender, holds a pointer to the node it is sending.
+   */
+  struct send_waiter : impl::sync_waiter {
+    node *value;
+    bool sent;
+  };
+
+  /**
+   * @brief A suspended receiver, the node is delivered here.
+   */
+  struct recv_waiter : impl::sync_waiter {
+    node *received;
+  };
+
+  /**
+   * @brief Take ownership of a received node and move its value out, ``std::nullopt`` if `received` is null.
+   */
+  static auto unbox(node *received) -> std::optional<T> {
+
+    std::unique_ptr<node> owner{received};
+
+    if (!owner) {
+      return std::nullopt;
+    }
+
+    return std::move(owner->value);
+  }
+
+  /**
+   * @brief Append to the buffer, requires the lock.
+   */
+  void push_locked(node *value) noexcept {
+
+    impl::non_null(value)->next = nullptr;
+
+    if (m_tail == nullptr) {
+      m_head = value;
+    } else {
+      m_tail->next = value;
+    }
+
+    m_tail = value;
+    ++m_size;
+  }
+
+  /**
+   * @brief Remove the oldest value from the (non-empty) buffer, requires the lock.
+   */
+  auto pop_locked() noexcept -> node * {
+
+    node *out = impl::non_null(m_head);
+
+    if (m_head = out->next; m_head == nullptr) {
+      m_tail = nullptr;
+    }
+
+    --m_size;
+    return out;
+  }
+
+  /**
+   * @brief Try to send while holding the lock, returns true if the send completed.
+   *
+   * Only pointers are exchanged, ownership of `value` passes to the channel or a receiver iff `sent` is set.
+   * If a receiver is resumed it is returned via `woken`.
+   */
+  auto send_locked(node *value, bool &sent, impl::sync_waiter *&woken) noexcept -> bool {
+
+    if (m_closed) {
+      sent = false;
+      return true;
+    }
+
+    if (impl::sync_waiter *receiver = m_receivers.pop()) {
+      static_cast<recv_waiter *>(receiver)->received = value;
+      woken = receiver;
+      sent = true;
+      return true;
+    }
+
+    if (m_size < m_capacity) {
+      push_locked(value);
+      sent = true;
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Try to receive while holding the lock, returns true if the receive completed.
+   *
+   * If a sender is resumed (its node linked into the buffer) it is returned via `woken`.
+   */
+  auto recv_locked(node *&received, impl::sync_waiter *&woken) noexcept -> bool {
+
+    if (m_head != nullptr) {
+
+      received = pop_locked();
+
+      if (impl::sync_waiter *sender = m_senders.pop()) {
+        auto *waiter = static_cast<send_waiter *>(sender);
+        push_locked(waiter->value);
+        waiter->sent = true;
+        woken = sender;
+      }
+
+      return true;
+    }
+
+    return m_closed;
+  }
+
+ public:
+  /**
+   * @brief The capacity of an unbounded channel.
+   */
+  static constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * @brief An ``lf::core::context_switcher`` that sends a value, returns false if the channel is closed.
+   */
+  class [[nodiscard("This should be immediately co_awaited")]] send_awaitable {
+   public:
+    /**
+     * @brief Move construct, the waiter is only initialized when the task suspends.
+     */
+    send_awaitable(send_awaitable &&other) noexcept : m_chan{other.m_chan}, m_node{std::move(other.m_node)} {}
+
+    /**
+     * @brief Try to send without suspending.
+     */
+    auto await_ready() noexcept -> bool {
+
+      impl::sync_waiter *woken = nullptr;
+      bool done = false;
+
+      {
+        std::lock_guard guard{m_chan->m_spin};
+        done = m_chan->send_locked(m_node.get(), m_waiter.sent, woken);
+      }
+
+      impl::sync_resume_all(woken);
+      return done;
+    }
+
+    /**
+     * @brief Enqueue this task as a sender.
+     */
+    void await_suspend(submit_handle handle) noexcept {
+
+      m_waiter.handle = handle;
+      m_waiter.context = impl::tls::context();
+      m_waiter.next = nullptr;
+      m_waiter.value = m_node.get();
+
+      impl::sync_waiter *woken = nullptr;
+
+      {
+        std::lock_guard guard{m_chan->m_spin};
+
+        if (!m_chan->send_locked(m_node.get(), m_waiter.sent, woken)) {
+          m_chan->m_senders.push(&m_waiter);
+          return;
+        }
+      }
+
+      // State changed between `await_ready` and here.
+      impl::sync_resume_all(woken);
+      impl::sync_resume_all(&m_waiter);
+    }
+
+    /**
+     * @brief Return true if the value was sent.
+     */
+    [[nodiscard]] auto await_resume() noexcept -> bool {
+      if (m_waiter.sent) {
+        // Now owned by the channel or a receiver.
+        impl::ignore_t{} = m_node.release();
+      }
+      return m_waiter.sent;
+    }
+
+   private:
+    friend class channel;
+
+    send_awaitable(channel *chan, T &&value)
+        : m_chan{chan},
+          m_node{std::make_unique<node>(std::move(value))} {}
+
+    channel *m_chan;
+    std::unique_ptr<node> m_node;
+    send_waiter m_waiter{};
+  };
+
+  /**
+   * @brief An ``lf::core::context_switcher`` that receives a value, returns ``std::nullopt`` if the
+   * channel is closed and empty.
+   */
+  class [[nodiscard("This should be immediately co_awaited")]] recv_awaitable {
+   public:
+    /**
+     * @brief Move construct, the waiter is only initialized when the task suspends.
+     */
+    recv_awaitable(recv_awaitable &&other) noexcept : m_chan{other.m_chan} {}
+
+    /**
+     * @brief Try to receive without suspending.
+     */
+    auto await_ready() noexcept -> bool {
+
+      impl::sync_waiter *woken = nullptr;
+      bool done = false;
+
+      {
+        std::lock_guard guard{m_chan->m_spin};
+        done = m_chan->recv_locked(m_waiter.received, woken);
+      }
+
+      impl::sync_resume_all(woken);
+      return done;
+    }
+
+    /**
+     * @brief Enqueue this task as a receiver.
+     */
+    void await_suspend(submit_handle handle) noexcept {
+
+      m_waiter.handle = handle;
+      m_waiter.context = impl::tls::context();
+      m_waiter.next = nullptr;
+      m_waiter.received = nullptr;
+
+      impl::sync_waiter *woken = nullptr;
+
+      {
+        std::lock_guard guard{m_chan->m_spin};
+
+        if (!m_chan->recv_locked(m_waiter.received, woken)) {
+          m_chan->m_receivers.push(&m_waiter);
+          return;
+        }
+      }
+
+      // State changed between `await_ready` and here.
+      impl::sync_resume_all(woken);
+      impl::sync_resume_all(&m_waiter);
+    }
+
+    /**
+     * @brief Return the received value or ``std::nullopt`` if the channel is closed and empty.
+     *
+     * The value is moved out of the channel here, if the move throws then the value is lost.
+     */
+    [[nodiscard]] auto await_resume() -> std::optional<T> {
+      return unbox(std::exchange(m_waiter.received, nullptr));
+    }
+
+   private:
+    friend class channel;
+
+    explicit recv_awaitable(channel *chan) noexcept : m_chan{chan} {}
+
+    channel *m_chan;
+    recv_waiter m_waiter{};
+  };
+
+  /**
+   * @brief Construct a channel that can buffer up to `capacity` values, `capacity` must be non-zero.
+   */
+  explicit channel(std::size_t capacity = unbounded) : m_capacity{capacity} { LF_ASSERT(capacity > 0); }
+
+  /**
+   * @brief Produce an awaitable that sends `value`.
+   *
+   * The value is moved into a node allocated here, the channel's lock is never held while moving or
+   * allocating.
+   */
+  [[nodiscard]] auto send(T value) -> send_awaitable { return {this, std::move(value)}; }
+
+  /**
+   * @brief Produce an awaitable that receives a value.
+   */
+  [[nodiscard]] auto recv() noexcept -> recv_awaitable { return recv_awaitable{this}; }
+
+  /**
+   * @brief Send `value` without suspending, returns false if the channel is full or closed.
+   */
+  [[nodiscard]] auto try_send(T value) -> bool {
+
+    auto boxed = std::make_unique<node>(std::move(value));
+
+    impl::sync_waiter *woken = nullptr;
+    bool sent = false;
+
+    {
+      std::lock_guard guard{m_spin};
+      impl::ignore_t{} = send_locked(boxed.get(), sent, woken);
+    }
+
+    if (sent) {
+      impl::ignore_t{} = boxed.release();
+    }
+
+    impl::sync_resume_all(woken);
+    return sent;
+  }
+
+  /**
+   * @brief Receive a value without suspending, returns ``std::nullopt`` if the channel is empty.
+   */
+  [[nodiscard]] auto try_recv() -> std::optional<T> {
+
+    impl::sync_waiter *woken = nullptr;
+    node *received = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+      impl::ignore_t{} = recv_locked(received, woken);
+    }
+
+    impl::sync_resume_all(woken);
+    return unbox(received);
+  }
+
+  /**
+   * @brief Close the channel, idempotent.
+   *
+   * Suspended senders are resumed and fail, their values are dropped. Suspended receivers are resumed
+   * with ``std::nullopt`` (there can be none if the buffer is non-empty).
+   */
+  void close() {
+
+    impl::sync_queue woken;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      m_closed = true;
+
+      while (impl::sync_waiter *sender = m_senders.pop()) {
+        static_cast<send_waiter *>(sender)->sent = false;
+        woken.push(sender);
+      }
+
+      while (impl::sync_waiter *receiver = m_receivers.pop()) {
+        woken.push(receiver);
+      }
+    }
+
+    impl::sync_resume_all(woken.pop_all());
+  }
+
+  /**
+   * @brief Test if the channel has been closed.
+   */
+  [[nodiscard]] auto closed() noexcept -> bool {
+    std::lock_guard guard{m_spin};
+    return m_closed;
+  }
+
+  /**
+   * @brief Destroy the channel and any values left in its buffer.
+   */
+  ~channel() noexcept {
+    while (m_head != nullptr) {
+      delete pop_locked(); // NOLINT
+    }
+  }
+
+ private:
+  impl::sync_spinlock m_spin;
+  std::size_t m_capacity;
+  bool m_closed = false;
+  node *m_head = nullptr;
+  node *m_tail = nullptr;
+  std::size_t m_size = 0;
+  impl::sync_queue m_senders;
+  impl::sync_queue m_receivers;
+};
+
+static_assert(context_switcher<channel<int>::send_awaitable>);
+static_assert(context_switcher<channel<int>::recv_awaitable>);
+
+} // namespace lf
+
+#endif /* B83E5F1A_2C7D_4A96_9D04_6E1B8C3F7A52 */
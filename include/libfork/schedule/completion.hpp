@@ -0,0 +1,206 @@
+#ifndef B1F6D3E8_2A47_4C95_8E0B_7D5A9C3F1E62
+#define B1F6D3E8_2A47_4C95_8E0B_7D5A9C3F1E62
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>      // for atomic, memory_order_acq_rel, memory_order_acquire
+#include <concepts>    // for constructible_from
+#include <exception>   // for exception_ptr, rethrow_exception
+#include <type_traits> // for is_void_v
+#include <utility>     // for forward, move
+
+#include "libfork/core/eventually.hpp"   // for try_eventually
+#include "libfork/core/ext/context.hpp"  // for worker_context
+#include "libfork/core/ext/handles.hpp"  // for submit_handle
+#include "libfork/core/ext/tls.hpp"      // for context
+#include "libfork/core/impl/utility.hpp" // for immovable, non_null
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_LOG, LF_TRY, LF_CATCH_ALL
+#include "libfork/core/scheduler.hpp"    // for context_switcher
+#include "libfork/core/task.hpp"         // for returnable
+#include "libfork/schedule/sync.hpp"     // for sync_waiter
+
+/**
+ * @file completion.hpp
+ *
+ * @brief A one-shot channel from an external callback to a suspended task.
+ */
+
+namespace lf {
+
+/**
+ * @brief A one-shot completion, a task can wait for it to be set by any thread (i.e. a C-library callback).
+ *
+ * The completion is intended to live in the frame of the task that awaits it, it holds the result and the
+ * waiting task hence, it never allocates. At most one task may wait for a completion and it must be set
+ * exactly once. The setter must not touch the completion after `set_value` or `set_exception` returns as
+ * the waiting task may have already resumed and destroyed it.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    lf::completion<int> done;
+ *
+ *    c_library_start(request, [](void *ctx, int status) {
+ *      static_cast<lf::completion<int> *>(ctx)->set_value(status);
+ *    }, &done);
+ *
+ *    int status = co_await done.wait();
+ *
+ * \endrst
+ */
+template <returnable T = void>
+class completion : impl::immovable<completion<T>> {
+
+  /**
+   * @brief The value of `m_state` once the completion has been set.
+   */
+  static auto ready_tag() noexcept -> impl::sync_waiter * {
+    static constinit impl::sync_waiter sentinel{nullptr, nullptr, nullptr};
+    return &sentinel;
+  }
+
+  /**
+   * @brief Publish the result, resume the waiter if there is one.
+   */
+  void publish() noexcept {
+
+    impl::sync_waiter *waiter = m_state.exchange(ready_tag(), std::memory_order_acq_rel);
+
+    LF_ASSERT(waiter != ready_tag());
+
+    if (waiter != nullptr) {
+      LF_LOG("Completion resumes a task");
+      non_null(waiter->context)->schedule(waiter->handle);
+    }
+  }
+
+  /**
+   * @brief An ``lf::core::context_switcher`` that waits for the completion to be set.
+   */
+  class awaitable : impl::sync_waiter {
+   public:
+    /**
+     * @brief Bind to `self`.
+     */
+    explicit awaitable(completion *self) noexcept : impl::sync_waiter{}, m_self{self} {}
+
+    /**
+     * @brief Don't suspend if the completion is already set.
+     */
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return m_self->ready(); }
+
+    /**
+     * @brief Register as the waiter, if the completion was set in the meantime resume immediately.
+     */
+    void await_suspend(submit_handle caller) noexcept {
+
+      this->handle = caller;
+      this->context = impl::tls::context();
+
+      impl::sync_waiter *expect = nullptr;
+
+      if (!m_self->m_state.compare_exchange_strong(expect, this, std::memory_order_acq_rel)) {
+        LF_ASSERT(expect == ready_tag());
+        this->context->schedule(caller);
+      }
+    }
+
+    /**
+     * @brief Return the value or rethrow the exception the completion was set with.
+     */
+    auto await_resume() -> T {
+
+      LF_ASSERT(m_self->ready());
+
+      if (m_self->m_result.has_exception()) {
+        std::rethrow_exception(std::move(m_self->m_result).exception());
+      }
+
+      if constexpr (!std::is_void_v<T>) {
+        return *std::move(m_self->m_result);
+      }
+    }
+
+   private:
+    completion *m_self;
+  };
+
+  static_assert(context_switcher<awaitable>);
+
+ public:
+  /**
+   * @brief Construct an unset completion.
+   */
+  completion() = default;
+
+  /**
+   * @brief Set the completion and resume the waiting task (if any), may be called by any thread.
+   */
+  void set_value()
+    requires std::is_void_v<T>
+  {
+    publish();
+  }
+
+  /**
+   * @brief Set the completion with `value` and resume the waiting task (if any), may be called by any thread.
+   */
+  template <typename U>
+    requires (!std::is_void_v<T>) && std::constructible_from<T, U>
+  void set_value(U &&value) {
+    m_result = std::forward<U>(value);
+    publish();
+  }
+
+  /**
+   * @brief Set the completion with an exception and resume the waiting task (if any).
+   *
+   * Awaiting the completion will rethrow `error`, may be called by any thread.
+   */
+  void set_exception(std::exception_ptr error) noexcept {
+
+    // clang-format off
+
+    LF_TRY {
+      std::rethrow_exception(std::move(error));
+    } LF_CATCH_ALL {
+      stash_exception(m_result);
+    }
+
+    // clang-format on
+
+    publish();
+  }
+
+  /**
+   * @brief Test if the completion has been set.
+   */
+  [[nodiscard]] auto ready() const noexcept -> bool {
+    return m_state.load(std::memory_order_acquire) == ready_tag();
+  }
+
+  /**
+   * @brief Produce an ``lf::core::context_switcher`` that waits for the completion to be set.
+   *
+   * Awaiting this returns the value (or rethrows the exception) the completion was set with, the task is
+   * resumed on the worker it suspended on.
+   */
+  [[nodiscard]] auto wait() noexcept -> awaitable { return awaitable{this}; }
+
+ private:
+  std::atomic<impl::sync_waiter *> m_state = nullptr;
+  try_eventually<T> m_result;
+};
+
+} // namespace lf
+
+#endif /* B1F6D3E8_2A47_4C95_8E0B_7D5A9C3F1E62 */
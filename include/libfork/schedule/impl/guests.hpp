@@ -0,0 +1,352 @@
+#ifndef E4A7C2D9_3B61_4F08_8D5E_1C9F7A2B6E40
+#define E4A7C2D9_3B61_4F08_8D5E_1C9F7A2B6E40
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>       // for array
+#include <atomic>      // for atomic, memory_order_acquire, memory_order_release, memory_order_relaxed
+#include <bit>         // for bit_cast
+#include <cstddef>     // for size_t
+#include <exception>   // for rethrow_exception
+#include <thread>      // for yield
+#include <type_traits> // for decay_t, is_void_v
+#include <utility>     // for forward, move
+
+#include "libfork/core/ext/context.hpp"         // for worker_context, nullary_function_t
+#include "libfork/core/ext/deque.hpp"           // for err
+#include "libfork/core/ext/handles.hpp"         // for submit_handle, task_handle
+#include "libfork/core/ext/list.hpp"            // for for_each_elem
+#include "libfork/core/ext/tls.hpp"             // for worker_init, finalize, thread_stack, has_stack
+#include "libfork/core/impl/frame.hpp"          // for frame
+#include "libfork/core/impl/notifier.hpp"       // for root_continuation
+#include "libfork/core/impl/stack.hpp"          // for stack
+#include "libfork/core/impl/utility.hpp"        // for k_cache_line, immovable
+#include "libfork/core/invocable.hpp"           // for async_result_t, async_tag_invocable
+#include "libfork/core/macro.hpp"               // for LF_ASSERT, LF_TRY, LF_CATCH_ALL, LF_RETHROW
+#include "libfork/core/sync_wait.hpp"           // for launch_root, future_shared_state, sync_wait
+#include "libfork/core/tag.hpp"                 // for tag
+#include "libfork/schedule/ext/event_count.hpp" // for event_count
+
+/**
+ * @file guests.hpp
+ *
+ * @brief Let a thread outside a pool temporarily join it as a worker.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief The contexts of the threads temporarily working for a pool, workers steal from these.
+ *
+ * A guest joins with a context and must leave before destroying it, leaving waits for any thief that may
+ * be observing the context.
+ */
+class guest_list : immovable<guest_list> {
+
+  /**
+   * @brief The maximum number of concurrent guests.
+   */
+  static constexpr std::size_t k_slots = 8;
+
+  /**
+   * @brief Padded to avoid false sharing between thieves.
+   */
+  struct alignas(k_cache_line) user_count {
+    std::atomic<std::size_t> value = 0;
+  };
+
+ public:
+  /**
+   * @brief Returned by `join` if there is no room for another guest.
+   */
+  static constexpr std::size_t npos = k_slots;
+
+  /**
+   * @brief Publish `context` to the thieves, returns its slot or `npos` if all the slots are taken.
+   */
+  [[nodiscard]] auto join(worker_context *context) noexcept -> std::size_t {
+    for (std::size_t i = 0; i < k_slots; ++i) {
+
+      worker_context *expect = nullptr;
+
+      if (m_contexts[i].compare_exchange_strong(expect, non_null(context), std::memory_order_seq_cst)) {
+        m_active.fetch_add(1, std::memory_order_relaxed);
+        return i;
+      }
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Retract the context in `slot`, after this returns no thief is observing it.
+   */
+  void leave(std::size_t slot) noexcept {
+
+    LF_ASSERT(slot < k_slots);
+
+    m_contexts[slot].store(nullptr, std::memory_order_seq_cst);
+    m_active.fetch_sub(1, std::memory_order_relaxed);
+
+    while (m_users[slot].value.load(std::memory_order_seq_cst) != 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @brief Try to steal a task from one of the guests, returns `nullptr` if we failed.
+   */
+  [[nodiscard]] auto try_steal() noexcept -> task_handle {
+
+    // Fast path, there are almost never any guests. A stale count only delays a steal.
+    if (m_active.load(std::memory_order_relaxed) == 0) {
+      return nullptr;
+    }
+
+    for (std::size_t i = 0; i < k_slots; ++i) {
+
+      if (m_contexts[i].load(std::memory_order_relaxed) == nullptr) {
+        continue;
+      }
+
+      task_handle task = nullptr;
+
+      // Announce ourselves before (re)loading the context, pairs with `leave`.
+      m_users[i].value.fetch_add(1, std::memory_order_seq_cst);
+
+      if (worker_context *context = m_contexts[i].load(std::memory_order_seq_cst)) {
+        if (auto [err, stolen] = context->try_steal(); err == lf::err::none) {
+          task = stolen;
+        }
+      }
+
+      m_users[i].value.fetch_sub(1, std::memory_order_release);
+
+      if (task != nullptr) {
+        return task;
+      }
+    }
+
+    return nullptr;
+  }
+
+ private:
+  alignas(k_cache_line) std::atomic<std::size_t> m_active = 0;
+  alignas(k_cache_line) std::array<std::atomic<worker_context *>, k_slots> m_contexts = {};
+  std::array<user_count, k_slots> m_users = {};
+};
+
+/**
+ * @brief Wakes a guest when it has new submissions or its root task completes.
+ *
+ * Every call into this object finishes by incrementing `notified` such that, once the guest has observed
+ * all of them, it can safely destroy this object.
+ */
+struct guest_signal : root_continuation {
+
+  /**
+   * @brief Construct a signal, the continuation calls `complete`.
+   */
+  guest_signal() noexcept : root_continuation{&complete} {}
+
+  /**
+   * @brief Called by the root notifier.
+   */
+  static void complete(root_continuation *self) noexcept {
+    auto *signal = static_cast<guest_signal *>(self);
+    // Must be visible before the wake-up otherwise, the guest could go back to sleep.
+    signal->done.store(true, std::memory_order_release);
+    signal->event.notify_all();
+    signal->notified.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Called by the guest's context when a task is submitted to it.
+   */
+  void submitted() noexcept {
+    event.notify_all();
+    notified.fetch_add(1, std::memory_order_release);
+  }
+
+  event_count event;
+  std::atomic<bool> done = false;
+  std::atomic<std::size_t> notified = 0;
+};
+
+/**
+ * @brief Destroy a root task, built by `launch_root` on this thread, that was never submitted.
+ *
+ * The root's stacklet is adopted by a temporary stack such that the frame is deallocated from the top.
+ */
+inline void destroy_root(submit_handle root) {
+  for_each_elem(root, [](submit_t *raw) {
+    //
+    auto *frame = std::bit_cast<impl::frame *>(raw);
+
+    tls::thread_stack.construct(stack::root_cache_t{});
+    tls::has_stack = true;
+
+    tls::thread_stack->adopt(frame->stacklet());
+    frame->self().destroy();
+
+    tls::thread_stack.destroy();
+    tls::has_stack = false;
+  });
+}
+
+/**
+ * @brief Run a root task with the calling thread as a temporary worker of the pool that owns `vars`.
+ *
+ * `Vars` must expose a `guest_list guests` and an `active_work(handle)` that resumes `handle` while
+ * upholding the pool's invariants. If the thread cannot join (no free slot or allocation failure) the
+ * root is scheduled on `sch` and the thread waits instead.
+ */
+template <typename Vars, scheduler Sch, async_function_object F, class... Args>
+  requires rootable<F, Args...>
+auto caller_runs(Vars &vars, Sch &sch, F &&fun, Args &&...args) -> async_result_t<F, Args...> {
+
+  using result_t = async_result_t<F, Args...>;
+  using state_t = future_shared_state<result_t>;
+
+  if constexpr (!async_tag_invocable<state_t *, tag::root, std::decay_t<F>, Args...>) {
+    // Extern functions are only instantiated for a heap allocated shared state.
+    return sync_wait(sch, std::forward<F>(fun), std::forward<Args>(args)...);
+  } else {
+
+    state_t state;
+    guest_signal signal;
+
+    submit_handle root = nullptr;
+
+    launch_root(
+        &state,
+        [&](submit_handle node) noexcept {
+          root = node;
+        },
+        std::forward<F>(fun),
+        std::forward<Args>(args)...);
+
+    // The root has not started hence, attaching cannot fail.
+    LF_ASSERT(root != nullptr);
+    ignore_t{} = state.notify.then(&signal);
+
+    auto wait_until_done = [&signal]() noexcept {
+      while (!signal.done.load(std::memory_order_acquire)) {
+
+        auto key = signal.event.prepare_wait();
+
+        if (signal.done.load(std::memory_order_acquire)) {
+          signal.event.cancel_wait();
+          return;
+        }
+
+        signal.event.wait(key);
+      }
+    };
+
+    // Wait for the `count` calls into `signal` (including completion) to have finished.
+    auto wait_until_quiet = [&signal](std::size_t count) noexcept {
+      while (signal.notified.load(std::memory_order_acquire) != count) {
+        std::this_thread::yield();
+      }
+    };
+
+    worker_context *context = nullptr;
+
+    // clang-format off
+
+    LF_TRY {
+      context = worker_init(nullary_function_t{[&signal]() noexcept {
+        signal.submitted();
+      }});
+    } LF_CATCH_ALL {
+      context = nullptr;
+    }
+
+    // clang-format on
+
+    std::size_t slot = context ? vars.guests.join(context) : guest_list::npos;
+
+    if (slot == guest_list::npos) {
+
+      if (context != nullptr) {
+        finalize(context);
+      }
+
+      // clang-format off
+
+      LF_TRY {
+        sch.schedule(root);
+      } LF_CATCH_ALL {
+        // We still own the root, it has not started.
+        destroy_root(root);
+        LF_RETHROW;
+      }
+
+      // clang-format on
+
+      wait_until_done();
+      wait_until_quiet(1);
+
+    } else {
+
+      std::size_t popped = 0;
+
+      vars.active_work(root);
+
+      while (true) {
+
+        if (submit_handle submissions = context->try_pop_all()) {
+          for_each_elem(submissions, [&popped](submit_t *) noexcept {
+            ++popped;
+          });
+          vars.active_work(submissions);
+          continue;
+        }
+
+        auto key = signal.event.prepare_wait();
+
+        if (signal.done.load(std::memory_order_acquire)) {
+          signal.event.cancel_wait();
+          break;
+        }
+
+        if (submit_handle submissions = context->try_pop_all()) {
+          signal.event.cancel_wait();
+          for_each_elem(submissions, [&popped](submit_t *) noexcept {
+            ++popped;
+          });
+          vars.active_work(submissions);
+          continue;
+        }
+
+        signal.event.wait(key);
+      }
+
+      // The root has completed hence, our deque is empty and nothing more will be submitted to us.
+      vars.guests.leave(slot);
+
+      // Wait for the submitters and the root to have finished notifying us.
+      wait_until_quiet(popped + 1);
+
+      finalize(context);
+    }
+
+    if (state.has_exception()) {
+      std::rethrow_exception(std::move(state).exception());
+    }
+
+    if constexpr (!std::is_void_v<result_t>) {
+      return *std::move(state);
+    }
+  }
+}
+
+} // namespace lf::impl
+
+#endif /* E4A7C2D9_3B61_4F08_8D5E_1C9F7A2B6E40 */
@@ -0,0 +1,48 @@
+#ifndef B3BBF80F_B874_425A_AB01_2EF2C20507BF
+#define B3BBF80F_B874_425A_AB01_2EF2C20507BF
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic> // for atomic, memory_order_acquire, memory_order_release
+
+/**
+ * @file idle.hpp
+ *
+ * @brief A hook that lets a service do work on the workers of a `lf::lazy_pool` before they sleep.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief The signature of an idle hook, it must not block.
+ */
+using idle_hook_t = void (*)() noexcept;
+
+/**
+ * @brief The registered hook, there is at most one (the I/O service's).
+ */
+inline std::atomic<idle_hook_t> idle_hook = nullptr;
+
+/**
+ * @brief Register `hook` to be called by idle workers, `nullptr` to unregister.
+ */
+inline void set_idle_hook(idle_hook_t hook) noexcept { idle_hook.store(hook, std::memory_order_release); }
+
+/**
+ * @brief Call the registered hook, if any.
+ */
+inline void call_idle_hook() noexcept {
+  if (idle_hook_t hook = idle_hook.load(std::memory_order_acquire)) {
+    hook();
+  }
+}
+
+} // namespace lf::impl
+
+#endif /* B3BBF80F_B874_425A_AB01_2EF2C20507BF */
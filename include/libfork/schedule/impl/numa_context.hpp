@@ -174,10 +174,15 @@ struct numa_context {
   [[nodiscard]] auto try_pop_all() noexcept -> submit_handle { return non_null(m_context)->try_pop_all(); }
 
   /**
-   * @brief Try to steal a task from one of our friends, returns `nullptr` if we failed.
+   * @brief Try to steal a task from one of our friends (or a guest), returns `nullptr` if we failed.
    */
   [[nodiscard]] auto try_steal() noexcept -> task_handle {
 
+    // Threads temporarily working for the pool are checked first, they are usually the source of work.
+    if (task_handle task = shared().guests.try_steal()) {
+      return task;
+    }
+
     if (m_neigh.empty()) {
       return nullptr;
     }
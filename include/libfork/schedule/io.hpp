@@ -0,0 +1,926 @@
+#ifndef B9F03D6E_5C2A_4E81_A7D4_61E8C0B3F25A
+#define B9F03D6E_5C2A_4E81_A7D4_61E8C0B3F25A
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>    // for max, min
+#include <array>        // for array
+#include <atomic>       // for atomic_flag, atomic_ref, atomic, memory_order_acquire, ...
+#include <cerrno>       // for errno, EINTR, EAGAIN, EBUSY, EEXIST, EPERM, ENOTSOCK
+#include <cstddef>      // for size_t, byte
+#include <cstdint>      // for int64_t, uint32_t, uint64_t, uint8_t
+#include <cstdlib>      // for getenv
+#include <exception>    // for terminate
+#include <limits>       // for numeric_limits
+#include <memory>       // for unique_ptr
+#include <span>         // for span
+#include <system_error> // for system_error, system_category
+#include <thread>       // for thread
+#include <utility>      // for exchange
+
+#include "libfork/core/ext/context.hpp"          // for worker_context
+#include "libfork/core/ext/handles.hpp"          // for submit_handle
+#include "libfork/core/ext/list.hpp"             // for intrusive_list, for_each_elem
+#include "libfork/core/ext/tls.hpp"              // for context
+#include "libfork/core/impl/manual_lifetime.hpp" // for manual_lifetime
+#include "libfork/core/impl/utility.hpp"         // for immovable, non_null
+#include "libfork/core/invocable.hpp"            // for ignore_t
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_LOG, LF_THROW
+#include "libfork/core/scheduler.hpp"            // for context_switcher
+#include "libfork/schedule/impl/idle.hpp"        // for set_idle_hook
+
+/**
+ * @file io.hpp
+ *
+ * @brief Context switchers that suspend a task until an I/O operation completes (Linux only).
+ *
+ * I/O is submitted to a process-wide service backed by `io_uring` if the kernel supports it, otherwise
+ * by `epoll`. The `epoll` backend can be forced by defining `LF_NO_IO_URING` or, at runtime, by setting the
+ * `LF_NO_IO_URING` environment variable before the first I/O operation.
+ */
+
+#ifdef __linux__
+
+  #include <fcntl.h>          // for F_DUPFD_CLOEXEC, fcntl
+  #include <linux/io_uring.h> // for io_uring_params, io_uring_sqe, io_uring_cqe, IORING_...
+  #include <poll.h>           // for pollfd, poll
+  #include <sys/epoll.h>      // for epoll_event, epoll_create1, epoll_ctl, epoll_wait
+  #include <sys/eventfd.h>    // for eventfd
+  #include <sys/mman.h>       // for mmap, munmap
+  #include <sys/socket.h>     // for accept4, recv, send, sockaddr, socklen_t, MSG_DONTWAIT
+  #include <sys/syscall.h>    // for __NR_io_uring_setup, __NR_io_uring_enter
+  #include <unistd.h>         // for read, write, pread, pwrite, fsync, close, syscall
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief The I/O operations supported by the I/O service.
+ */
+enum class io_op : std::uint8_t {
+  read,
+  write,
+  accept,
+  poll,
+  fsync,
+};
+
+/**
+ * @brief An I/O operation, lives in the suspended task's frame.
+ */
+struct io_request {
+  /**
+   * @brief The operation to perform.
+   */
+  io_op op;
+  /**
+   * @brief The file descriptor to operate on.
+   */
+  int fd;
+  /**
+   * @brief Buffer for read/write, address for accept.
+   */
+  void *addr = nullptr;
+  /**
+   * @brief Length of the buffer for read/write.
+   */
+  std::size_t len = 0;
+  /**
+   * @brief Offset for read/write, `-1` to use (and update) the file position.
+   */
+  std::int64_t offset = -1;
+  /**
+   * @brief Length of the address for accept.
+   */
+  socklen_t *addrlen = nullptr;
+  /**
+   * @brief Events for poll.
+   */
+  std::uint32_t events = 0;
+  /**
+   * @brief The suspended task.
+   */
+  submit_handle handle = nullptr;
+  /**
+   * @brief The worker the task will be resumed on.
+   */
+  worker_context *context = nullptr;
+  /**
+   * @brief The result of the operation, negative values are `-errno`.
+   */
+  std::int64_t result = 0;
+  /**
+   * @brief The file descriptor registered with epoll, may be a duplicate of `fd`.
+   */
+  int armed_fd = -1;
+  /**
+   * @brief The next request in one of the epoll backend's lists of ready/deferred operations.
+   */
+  io_request *next = nullptr;
+};
+
+/**
+ * @brief A node in the I/O service's submission list, embedded in the suspended task's frame.
+ */
+using io_node = intrusive_list<io_request *>::node;
+
+/**
+ * @brief Perform an I/O operation synchronously, returns the result or `-errno`.
+ *
+ * If `nowait` then the operation returns `-EAGAIN` rather than blocking, sockets are read/written with
+ * `MSG_DONTWAIT` and other file descriptors are polled first (accept has no per-call flag).
+ */
+inline auto io_perform(io_request const &req, bool nowait = false) noexcept -> std::int64_t {
+
+  std::int64_t res = -1;
+
+  if (nowait && req.op != io_op::poll) {
+    // The readiness reported by epoll may have been consumed by another thread.
+    ::pollfd pfd{req.fd, static_cast<short>(req.op == io_op::write ? POLLOUT : POLLIN), 0};
+    if (::poll(&pfd, 1, 0) == 0) {
+      return -EAGAIN;
+    }
+  }
+
+  switch (req.op) {
+    case io_op::read:
+      if (req.offset >= 0) {
+        res = ::pread(req.fd, req.addr, req.len, req.offset);
+      } else {
+        res = nowait ? ::recv(req.fd, req.addr, req.len, MSG_DONTWAIT) : -1;
+        if (!nowait || (res < 0 && errno == ENOTSOCK)) {
+          res = ::read(req.fd, req.addr, req.len);
+        }
+      }
+      break;
+    case io_op::write:
+      if (req.offset >= 0) {
+        res = ::pwrite(req.fd, req.addr, req.len, req.offset);
+      } else {
+        res = nowait ? ::send(req.fd, req.addr, req.len, MSG_DONTWAIT) : -1;
+        if (!nowait || (res < 0 && errno == ENOTSOCK)) {
+          res = ::write(req.fd, req.addr, req.len);
+        }
+      }
+      break;
+    case io_op::accept:
+      res = ::accept4(req.fd, static_cast<sockaddr *>(req.addr), req.addrlen, SOCK_CLOEXEC);
+      break;
+    case io_op::poll: {
+      ::pollfd pfd{req.fd, static_cast<short>(req.events), 0};
+      res = ::poll(&pfd, 1, 0);
+      if (res == 0) {
+        return -EAGAIN;
+      }
+      if (res > 0) {
+        res = static_cast<std::uint16_t>(pfd.revents);
+      }
+      break;
+    }
+    case io_op::fsync:
+      res = ::fsync(req.fd);
+      break;
+  }
+
+  return res < 0 ? -errno : res;
+}
+
+/**
+ * @brief Store the result and reschedule the task on the worker it was suspended on.
+ */
+inline void io_complete(io_request *req, std::int64_t res) noexcept {
+
+  LF_LOG("I/O completed, rescheduling task");
+
+  non_null(req)->result = res;
+  // Cannot touch `req` after this as the task may have been resumed.
+  non_null(req->context)->schedule(req->handle);
+}
+
+/**
+ * @brief A thin wrapper around a raw (no liburing) `io_uring` instance.
+ *
+ * All member functions other than `wait` must be called with the service lock held. Functions that may
+ * need to make room in the completion queue call `fun(user_data, res)` for each completion they reap.
+ */
+class uring : immovable<uring> {
+
+  static auto setup(unsigned entries, io_uring_params *params) noexcept -> int {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+  }
+
+  static auto enter(int fd, unsigned submit, unsigned complete, unsigned flags) noexcept -> int {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, submit, complete, flags, nullptr, 0));
+  }
+
+  /**
+   * @brief The largest length an `io_uring_sqe` can carry.
+   */
+  static constexpr std::size_t k_max_len = std::numeric_limits<std::uint32_t>::max();
+
+  template <typename T>
+  auto at(std::uint32_t offset) const noexcept -> T * {
+    return reinterpret_cast<T *>(static_cast<std::byte *>(m_ring) + offset);
+  }
+
+ public:
+  /**
+   * @brief Attempt to create an `io_uring`, check `valid()` for success.
+   */
+  explicit uring(unsigned entries) noexcept {
+
+    io_uring_params params{};
+
+    if (m_fd = setup(entries, &params); m_fd < 0) {
+      return;
+    }
+
+    constexpr unsigned required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+
+    if ((params.features & required) != required) {
+      ::close(std::exchange(m_fd, -1));
+      return;
+    }
+
+    std::size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    std::size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    m_ring_size = std::max(sq_size, cq_size);
+    m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    constexpr int prot = PROT_READ | PROT_WRITE;
+    constexpr int flags = MAP_SHARED | MAP_POPULATE;
+
+    m_ring = ::mmap(nullptr, m_ring_size, prot, flags, m_fd, IORING_OFF_SQ_RING);
+    m_sqes = ::mmap(nullptr, m_sqes_size, prot, flags, m_fd, IORING_OFF_SQES);
+
+    if (m_ring == MAP_FAILED || m_sqes == MAP_FAILED) {
+      release();
+      return;
+    }
+
+    m_entries = params.sq_entries;
+    m_sq_head = at<unsigned>(params.sq_off.head);
+    m_sq_tail = at<unsigned>(params.sq_off.tail);
+    m_sq_mask = *at<unsigned>(params.sq_off.ring_mask);
+    m_sq_array = at<unsigned>(params.sq_off.array);
+    m_cq_head = at<unsigned>(params.cq_off.head);
+    m_cq_tail = at<unsigned>(params.cq_off.tail);
+    m_cq_mask = *at<unsigned>(params.cq_off.ring_mask);
+    m_cqes = at<io_uring_cqe>(params.cq_off.cqes);
+  }
+
+  /**
+   * @brief Test if the kernel supports (and allowed) the creation of this ring.
+   */
+  [[nodiscard]] auto valid() const noexcept -> bool { return m_fd >= 0; }
+
+  /**
+   * @brief Queue an operation, `user_data == nullptr` is reserved for the wake-up read.
+   */
+  template <typename F>
+  void push(io_request const &req, void *user_data, F &&fun) noexcept {
+
+    unsigned tail = *m_sq_tail;
+
+    if (tail - std::atomic_ref{*m_sq_head}.load(std::memory_order_acquire) == m_entries) {
+      flush(fun);
+    }
+
+    unsigned idx = tail & m_sq_mask;
+
+    io_uring_sqe *sqe = static_cast<io_uring_sqe *>(m_sqes) + idx;
+
+    *sqe = {};
+    sqe->fd = req.fd;
+    sqe->user_data = reinterpret_cast<std::uint64_t>(user_data);
+
+    switch (req.op) {
+      case io_op::read:
+      case io_op::write:
+        sqe->opcode = req.op == io_op::read ? IORING_OP_READ : IORING_OP_WRITE;
+        sqe->addr = reinterpret_cast<std::uint64_t>(req.addr);
+        // Longer transfers are reported as short reads/writes.
+        sqe->len = static_cast<std::uint32_t>(std::min<std::size_t>(req.len, k_max_len));
+        sqe->off = static_cast<std::uint64_t>(req.offset);
+        break;
+      case io_op::accept:
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->addr = reinterpret_cast<std::uint64_t>(req.addr);
+        sqe->addr2 = reinterpret_cast<std::uint64_t>(req.addrlen);
+        sqe->accept_flags = SOCK_CLOEXEC;
+        break;
+      case io_op::poll:
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->poll32_events = req.events;
+        break;
+      case io_op::fsync:
+        sqe->opcode = IORING_OP_FSYNC;
+        break;
+    }
+
+    m_sq_array[idx] = idx;
+
+    std::atomic_ref{*m_sq_tail}.store(tail + 1, std::memory_order_release);
+
+    ++m_pending;
+  }
+
+  /**
+   * @brief Hand all queued operations to the kernel.
+   *
+   * If the completion queue is full (`EBUSY`) then completions are reaped, only this can make room.
+   */
+  template <typename F>
+  void flush(F &&fun) noexcept {
+    while (m_pending > 0) {
+      if (int res = enter(m_fd, m_pending, 0, 0); res >= 0) {
+        m_pending -= static_cast<unsigned>(res);
+      } else if (errno == EBUSY) {
+        reap(fun);
+      } else if (errno != EINTR && errno != EAGAIN) {
+        // The ring is unusable, nothing sensible can be done.
+        LF_ASSERT(false && "io_uring_enter failed");
+        std::terminate();
+      }
+    }
+  }
+
+  /**
+   * @brief Block until at least one completion is available, does not require the lock.
+   */
+  void wait() const noexcept { ignore_t{} = enter(m_fd, 0, 1, IORING_ENTER_GETEVENTS); }
+
+  /**
+   * @brief Call `fun(user_data, res)` for each available completion.
+   */
+  template <typename F>
+  void reap(F &&fun) noexcept {
+
+    unsigned head = *m_cq_head;
+    unsigned tail = std::atomic_ref{*m_cq_tail}.load(std::memory_order_acquire);
+
+    for (; head != tail; ++head) {
+      io_uring_cqe const &cqe = m_cqes[head & m_cq_mask];
+      fun(reinterpret_cast<void *>(cqe.user_data), static_cast<std::int64_t>(cqe.res));
+    }
+
+    std::atomic_ref{*m_cq_head}.store(head, std::memory_order_release);
+  }
+
+  /**
+   * @brief Unmap the rings and close the file descriptor.
+   */
+  ~uring() noexcept { release(); }
+
+ private:
+  void release() noexcept {
+    if (m_sqes != nullptr && m_sqes != MAP_FAILED) {
+      ::munmap(std::exchange(m_sqes, nullptr), m_sqes_size);
+    }
+    if (m_ring != nullptr && m_ring != MAP_FAILED) {
+      ::munmap(std::exchange(m_ring, nullptr), m_ring_size);
+    }
+    if (m_fd >= 0) {
+      ::close(std::exchange(m_fd, -1));
+    }
+  }
+
+  int m_fd = -1;
+  unsigned m_entries = 0;
+  unsigned m_pending = 0;
+
+  void *m_ring = nullptr;
+  void *m_sqes = nullptr;
+  std::size_t m_ring_size = 0;
+  std::size_t m_sqes_size = 0;
+
+  unsigned *m_sq_head = nullptr;
+  unsigned *m_sq_tail = nullptr;
+  unsigned *m_sq_array = nullptr;
+  unsigned m_sq_mask = 0;
+
+  unsigned *m_cq_head = nullptr;
+  unsigned *m_cq_tail = nullptr;
+  io_uring_cqe *m_cqes = nullptr;
+  unsigned m_cq_mask = 0;
+};
+
+/**
+ * @brief A process-wide I/O reactor.
+ *
+ * Submitting an operation is lock-free and allocates no memory: the request is pushed onto an intrusive
+ * list and a dedicated thread is woken via an `eventfd`. The dedicated thread blocks in the kernel until
+ * an operation completes then reschedules the waiting task on the worker it was suspended on. Idle workers
+ * can opportunistically reap completions via `try_reap`.
+ *
+ * Operations that `epoll` cannot wait for (`fsync` and regular files) are performed by the dedicated thread,
+ * never by a worker. Operations that `epoll` reports ready are performed (without blocking) after the
+ * service lock has been released.
+ */
+class io_service : immovable<io_service> {
+
+  static constexpr unsigned k_entries = 256;
+  static constexpr int k_events = 64;
+
+ public:
+  /**
+   * @brief Start the service, throws `std::system_error` if the kernel objects cannot be created.
+   */
+  io_service() : m_uring{want_uring() ? std::make_unique<uring>(k_entries) : nullptr} {
+
+    if (m_uring && !m_uring->valid()) {
+      m_uring = nullptr;
+    }
+
+    if (m_wake = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK); m_wake < 0) {
+      LF_THROW(std::system_error(errno, std::system_category(), "eventfd"));
+    }
+
+    if (m_uring) {
+      m_rearm = true;
+      drain();
+    } else {
+      if (m_epoll = ::epoll_create1(EPOLL_CLOEXEC); m_epoll < 0) {
+        ::close(m_wake);
+        LF_THROW(std::system_error(errno, std::system_category(), "epoll_create1"));
+      }
+      ::epoll_event event{.events = EPOLLIN, .data = {.ptr = nullptr}};
+      ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &event);
+    }
+
+    m_thread = std::thread{[this] { loop(); }};
+
+    s_instance.store(this, std::memory_order_release);
+
+    set_idle_hook(&idle);
+  }
+
+  /**
+   * @brief Test if this service is backed by `io_uring`.
+   */
+  [[nodiscard]] auto uses_uring() const noexcept -> bool { return m_uring != nullptr; }
+
+  /**
+   * @brief Submit an operation, this can be called concurrently from any number of threads.
+   *
+   * The node must remain valid until the request has been completed.
+   */
+  void submit(io_node *node) noexcept {
+    m_submit.push(non_null(node));
+    notify();
+  }
+
+  /**
+   * @brief Reap completions (without blocking) if no-one else is, this is called by idle workers.
+   */
+  void try_reap() noexcept {
+    if (m_lock.test(std::memory_order_relaxed) || m_lock.test_and_set(std::memory_order_acquire)) {
+      return;
+    }
+    process();
+    io_request *ready = std::exchange(m_ready, nullptr);
+    unlock();
+    perform_ready(ready);
+  }
+
+  /**
+   * @brief Get a pointer to the running service or `nullptr` if it has not been started.
+   */
+  [[nodiscard]] static auto instance() noexcept -> io_service * {
+    return s_instance.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Stop the service, pending operations are abandoned.
+   */
+  ~io_service() noexcept {
+    set_idle_hook(nullptr);
+    s_instance.store(nullptr, std::memory_order_release);
+    m_stop.test_and_set(std::memory_order_release);
+    notify();
+    m_thread.join();
+    if (m_epoll >= 0) {
+      ::close(m_epoll);
+    }
+    m_uring = nullptr;
+    ::close(m_wake);
+  }
+
+ private:
+  /**
+   * @brief Test if `io_uring` should be tried.
+   */
+  static auto want_uring() noexcept -> bool {
+  #ifdef LF_NO_IO_URING
+    return false;
+  #else
+    return std::getenv("LF_NO_IO_URING") == nullptr; // NOLINT Only read, never set.
+  #endif
+  }
+
+  /**
+   * @brief The idle hook, reaps completions on behalf of the running service.
+   */
+  static void idle() noexcept {
+    if (io_service *service = instance()) {
+      service->try_reap();
+    }
+  }
+
+  void notify() noexcept {
+    std::uint64_t one = 1;
+    ignore_t{} = ::write(m_wake, &one, sizeof(one));
+  }
+
+  void lock() noexcept {
+    while (m_lock.test_and_set(std::memory_order_acquire)) {
+      m_lock.wait(true, std::memory_order_relaxed);
+    }
+  }
+
+  void unlock() noexcept {
+    m_lock.clear(std::memory_order_release);
+    m_lock.notify_one();
+  }
+
+  /**
+   * @brief Queue a request that cannot be polled for the dedicated thread, requires the lock.
+   *
+   * This may be called from a worker (in `try_reap`) hence the dedicated thread must be woken.
+   */
+  void defer(io_request *req) noexcept {
+    req->next = std::exchange(m_deferred, req);
+    notify();
+  }
+
+  /**
+   * @brief Perform every request in `head` and complete them, this can block hence must not hold the lock.
+   */
+  static void perform(io_request *head) noexcept {
+    while (head != nullptr) {
+      // Cannot touch `req` after completing it.
+      io_request *req = std::exchange(head, head->next);
+      io_complete(req, io_perform(*req));
+    }
+  }
+
+  /**
+   * @brief Perform every request in `head` without blocking, must not hold the lock.
+   *
+   * A request that would block (spurious readiness) is re-armed.
+   */
+  void perform_ready(io_request *head) noexcept {
+    while (head != nullptr) {
+      // Cannot touch `req` after completing it.
+      io_request *req = std::exchange(head, head->next);
+
+      if (std::int64_t res = io_perform(*req, true); res != -EAGAIN) {
+        io_complete(req, res);
+      } else {
+        lock();
+        arm(req);
+        unlock();
+      }
+    }
+  }
+
+  /**
+   * @brief Register a request with epoll or, if the file is not pollable, defer it.
+   */
+  void arm(io_request *req) noexcept {
+
+    if (req->op == io_op::fsync) {
+      return defer(req);
+    }
+
+    std::uint32_t mask = EPOLLONESHOT;
+
+    switch (req->op) {
+      case io_op::write:
+        mask |= EPOLLOUT;
+        break;
+      case io_op::poll:
+        mask |= req->events;
+        break;
+      default:
+        mask |= EPOLLIN;
+    }
+
+    ::epoll_event event{.events = mask, .data = {.ptr = req}};
+
+    req->armed_fd = req->fd;
+
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, req->armed_fd, &event) == 0) {
+      return;
+    }
+
+    if (errno == EEXIST) {
+      // Another operation is pending on this file descriptor, register a duplicate.
+      if (req->armed_fd = ::fcntl(req->fd, F_DUPFD_CLOEXEC, 0); req->armed_fd >= 0) {
+        if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, req->armed_fd, &event) == 0) {
+          return;
+        }
+        ::close(req->armed_fd);
+      }
+    }
+
+    req->armed_fd = -1;
+
+    if (errno == EPERM) {
+      // Regular files are not pollable.
+      return defer(req);
+    }
+
+    io_complete(req, -errno);
+  }
+
+  /**
+   * @brief An epoll registration fired, queue the operation to be performed outside the lock.
+   */
+  void ready(io_request *req, std::uint32_t revents) noexcept {
+
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, req->armed_fd, nullptr);
+
+    if (req->armed_fd != req->fd) {
+      ::close(req->armed_fd);
+    }
+
+    req->armed_fd = -1;
+
+    if (req->op == io_op::poll) {
+      return io_complete(req, revents);
+    }
+
+    req->next = std::exchange(m_ready, req);
+  }
+
+  /**
+   * @brief Handle an `io_uring` completion, requires the lock.
+   */
+  void complete(void *user_data, std::int64_t res) noexcept {
+    if (user_data == nullptr) {
+      m_rearm = true;
+    } else {
+      io_complete(static_cast<io_request *>(user_data), res);
+    }
+  }
+
+  /**
+   * @brief Submit/arm every request in the submission list, requires the lock.
+   *
+   * If the wake-up read has completed then it is resubmitted.
+   */
+  void drain() noexcept {
+
+    auto on_complete = [this](void *user_data, std::int64_t res) noexcept {
+      complete(user_data, res);
+    };
+
+    for_each_elem(m_submit.try_pop_all(), [&](io_request *req) {
+      if (m_uring) {
+        m_uring->push(*req, req, on_complete);
+      } else {
+        arm(req);
+      }
+    });
+
+    if (m_uring) {
+      if (std::exchange(m_rearm, false)) {
+        m_uring->push(wake_request(), nullptr, on_complete);
+      }
+      m_uring->flush(on_complete);
+    }
+  }
+
+  /**
+   * @brief Handle a batch of epoll events, requires the lock.
+   */
+  void dispatch(std::span<::epoll_event const> events) noexcept {
+
+    bool woken = false;
+
+    for (::epoll_event const &event : events) {
+      if (auto *req = static_cast<io_request *>(event.data.ptr)) {
+        ready(req, event.events);
+      } else {
+        std::uint64_t buf = 0;
+        ignore_t{} = ::read(m_wake, &buf, sizeof(buf));
+        woken = true;
+      }
+    }
+
+    if (woken) {
+      drain();
+    }
+  }
+
+  /**
+   * @brief Handle all available completions without blocking, requires the lock.
+   */
+  void process() noexcept {
+    if (m_uring) {
+
+      m_uring->reap([this](void *user_data, std::int64_t res) noexcept {
+        complete(user_data, res);
+      });
+
+      // Flushing may reap the wake-up read again.
+      while (m_rearm) {
+        drain();
+      }
+    } else {
+      std::array<::epoll_event, k_events> events; // NOLINT
+      int count = ::epoll_wait(m_epoll, events.data(), k_events, 0);
+      dispatch(std::span{events}.first(count > 0 ? static_cast<std::size_t>(count) : 0));
+    }
+  }
+
+  /**
+   * @brief The dedicated thread's event-loop, blocks in the kernel while nothing has completed.
+   */
+  void loop() noexcept {
+    while (!m_stop.test(std::memory_order_acquire)) {
+      if (m_uring) {
+        m_uring->wait();
+        lock();
+        process();
+        unlock();
+      } else {
+        // Epoll is thread-safe, no need to hold the lock while waiting.
+        std::array<::epoll_event, k_events> events; // NOLINT
+        int count = ::epoll_wait(m_epoll, events.data(), k_events, -1);
+        lock();
+        dispatch(std::span{events}.first(count > 0 ? static_cast<std::size_t>(count) : 0));
+        io_request *ready = std::exchange(m_ready, nullptr);
+        io_request *deferred = std::exchange(m_deferred, nullptr);
+        unlock();
+        perform_ready(ready);
+        perform(deferred);
+      }
+    }
+  }
+
+  /**
+   * @brief A read of the wake-up eventfd.
+   */
+  auto wake_request() noexcept -> io_request {
+    return {.op = io_op::read, .fd = m_wake, .addr = &m_wake_buf, .len = sizeof(m_wake_buf)};
+  }
+
+  inline static std::atomic<io_service *> s_instance = nullptr;
+
+  std::unique_ptr<uring> m_uring;
+  int m_epoll = -1;
+  int m_wake = -1;
+  std::uint64_t m_wake_buf = 0;
+  bool m_rearm = false;
+  io_request *m_deferred = nullptr;
+  io_request *m_ready = nullptr;
+
+  intrusive_list<io_request *> m_submit;
+  std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+  std::atomic_flag m_stop = ATOMIC_FLAG_INIT;
+  std::thread m_thread;
+};
+
+/**
+ * @brief Get the process-wide I/O service, started on first use.
+ */
+inline auto io() -> io_service & {
+  static io_service instance;
+  return instance;
+}
+
+} // namespace impl
+
+/**
+ * @brief An ``lf::core::context_switcher`` that suspends the awaiting task until an I/O operation completes.
+ *
+ * The task is resumed on the worker it was suspended on. Awaiting this returns the (non-negative) result
+ * of the operation or throws a `std::system_error` if the operation failed.
+ */
+class [[nodiscard("This should be immediately co_awaited")]] io_awaitable {
+ public:
+  /**
+   * @brief Construct an awaitable for `req`.
+   */
+  explicit io_awaitable(impl::io_request const &req) noexcept : m_req{req} {}
+
+  /**
+   * @brief Move construct, the submission node is only constructed when the task suspends.
+   */
+  io_awaitable(io_awaitable &&other) noexcept : m_req{other.m_req} {}
+
+  /**
+   * @brief Always suspend.
+   */
+  static auto await_ready() noexcept -> bool { return false; }
+
+  /**
+   * @brief Submit the operation to the I/O service.
+   */
+  void await_suspend(submit_handle handle) {
+
+    auto &service = impl::io();
+
+    m_req.handle = handle;
+    m_req.context = impl::tls::context();
+
+    service.submit(m_node.construct(&m_req));
+  }
+
+  /**
+   * @brief Return the result or throw a `std::system_error`.
+   */
+  auto await_resume() const -> std::int64_t {
+    if (m_req.result < 0) {
+      LF_THROW(std::system_error(static_cast<int>(-m_req.result), std::system_category()));
+    }
+    return m_req.result;
+  }
+
+ private:
+  impl::io_request m_req;
+  impl::manual_lifetime<impl::io_node> m_node;
+};
+
+static_assert(context_switcher<io_awaitable>);
+
+/**
+ * @brief Read up to `buf.size()` bytes from `fd` into `buf`, returns the number of bytes read.
+ *
+ * If `offset` is negative then the file position is used (and updated).
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::array<std::byte, 64> buf;
+ *
+ *    std::int64_t n = co_await lf::io_read(fd, buf);
+ *
+ * \endrst
+ */
+inline auto io_read(int fd, std::span<std::byte> buf, std::int64_t offset = -1) noexcept -> io_awaitable {
+  return io_awaitable{{
+      .op = impl::io_op::read,
+      .fd = fd,
+      .addr = buf.data(),
+      .len = buf.size(),
+      .offset = offset,
+  }};
+}
+
+/**
+ * @brief Write up to `buf.size()` bytes from `buf` to `fd`, returns the number of bytes written.
+ *
+ * If `offset` is negative then the file position is used (and updated).
+ */
+inline auto
+io_write(int fd, std::span<std::byte const> buf, std::int64_t offset = -1) noexcept -> io_awaitable {
+  return io_awaitable{{
+      .op = impl::io_op::write,
+      .fd = fd,
+      .addr = const_cast<std::byte *>(buf.data()), // NOLINT The buffer is never written to.
+      .len = buf.size(),
+      .offset = offset,
+  }};
+}
+
+/**
+ * @brief Accept a connection on the listening socket `fd`, returns the new (close-on-exec) socket.
+ */
+inline auto
+io_accept(int fd, sockaddr *addr = nullptr, socklen_t *addrlen = nullptr) noexcept -> io_awaitable {
+  return io_awaitable{{.op = impl::io_op::accept, .fd = fd, .addr = addr, .addrlen = addrlen}};
+}
+
+/**
+ * @brief Wait until any of the `poll(2)` `events` are signalled on `fd`, returns the signalled events.
+ */
+inline auto io_poll(int fd, short events) noexcept -> io_awaitable {
+  return io_awaitable{{.op = impl::io_op::poll, .fd = fd, .events = static_cast<std::uint16_t>(events)}};
+}
+
+/**
+ * @brief Synchronize the state of `fd` with the storage device, returns zero.
+ */
+inline auto io_fsync(int fd) noexcept -> io_awaitable {
+  return io_awaitable{{.op = impl::io_op::fsync, .fd = fd}};
+}
+
+} // namespace lf
+
+#endif
+
+#endif /* B9F03D6E_5C2A_4E81_A7D4_61E8C0B3F25A */
@@ -27,12 +27,14 @@
 #include "libfork/core/ext/handles.hpp"           // for submit_handle, task_handle
 #include "libfork/core/ext/resume.hpp"            // for resume
 #include "libfork/core/impl/utility.hpp"          // for k_cache_line
+#include "libfork/core/invocable.hpp"            // for async_function_object, rootable, async_result_t
 #include "libfork/core/macro.hpp"                 // for LF_ASSERT, LF_LOG, LF_ASSERT_NO_ASSUME
 #include "libfork/core/scheduler.hpp"             // for scheduler
 #include "libfork/schedule/busy_pool.hpp"         // for busy_vars
 #include "libfork/schedule/ext/event_count.hpp"   // for event_count
 #include "libfork/schedule/ext/numa.hpp"          // for numa_strategy, numa_topology
 #include "libfork/schedule/ext/random.hpp"        // for xoshiro, seed
+#include "libfork/schedule/impl/idle.hpp"         // for call_idle_hook
 #include "libfork/schedule/impl/numa_context.hpp" // for numa_context
 
 /**
@@ -116,6 +118,16 @@ struct lazy_vars : busy_vars {
     // A <- A + 1
     // Si <- Si - 1
 
+    active_work(handle);
+  }
+
+  /**
+   * Called by a (former) thief or a guest with work, effect: active, do work, inactive.
+   */
+  template <typename Handle>
+    requires std::same_as<Handle, task_handle> || std::same_as<Handle, submit_handle>
+  void active_work(Handle handle) noexcept {
+
     // If we are the first active then we need to maintain the invariant across all numa domains.
 
     if (active.fetch_add(1, acq_rel) == 0) {
@@ -210,6 +222,12 @@ wake_up:
     goto wake_up;
   }
 
+  /**
+   * Before sleeping, run the idle hook (which reaps completed I/O), this may reschedule waiting tasks
+   * onto their worker's submission queue (which may be ours, hence this must come before the final check).
+   */
+  call_idle_hook();
+
   /**
    * Now we are going to try and sleep if the conditions are correct.
    *
@@ -370,6 +388,23 @@ class lazy_pool {
    */
   void schedule(submit_handle job) { m_worker[m_dist(m_rng)]->schedule(job); }
 
+  /**
+   * @brief Run `fun` to completion with the calling thread temporarily joining the pool, returns the result.
+   *
+   * This is an alternative to ``lf::sync_wait(pool, fun, args...)`` in which the calling thread runs the
+   * root task itself, instead of sleeping while a worker is woken to run it. The pool's workers can steal
+   * from the calling thread until the root task completes, then the thread leaves the pool. The calling
+   * thread never steals from the pool, it only runs the root task's work that is not stolen from it.
+   *
+   * If the thread cannot join the pool (there is a small limit on the number of concurrent callers) this
+   * falls back to ``lf::sync_wait``.
+   */
+  template <async_function_object F, class... Args>
+    requires rootable<F, Args...>
+  auto caller_runs(F &&fun, Args &&...args) -> async_result_t<F, Args...> {
+    return impl::caller_runs(*m_share, *this, std::forward<F>(fun), std::forward<Args>(args)...);
+  }
+
   /**
    * @brief Get a view of the worker's contexts.
    */
@@ -0,0 +1,607 @@
+#ifndef A4D9E2B7_6C1F_4E38_B05A_8F3C7D1E9246
+#define A4D9E2B7_6C1F_4E38_B05A_8F3C7D1E9246
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>  // for atomic_flag, memory_order_acquire, memory_order_release
+#include <cstddef> // for ptrdiff_t
+#include <mutex>   // for lock_guard
+
+#include "libfork/core/ext/context.hpp"  // for worker_context
+#include "libfork/core/ext/handles.hpp"  // for submit_handle
+#include "libfork/core/ext/tls.hpp"      // for context
+#include "libfork/core/impl/utility.hpp" // for immovable, non_null
+#include "libfork/core/invocable.hpp"    // for ignore_t
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_LOG
+#include "libfork/core/scheduler.hpp"    // for context_switcher
+
+/**
+ * @file sync.hpp
+ *
+ * @brief Synchronization primitives that suspend tasks instead of blocking workers.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief A suspended task waiting on a synchronization primitive, lives in the task's frame.
+ */
+struct sync_waiter {
+  /**
+   * @brief The suspended task.
+   */
+  submit_handle handle;
+  /**
+   * @brief The worker the task will be resumed on.
+   */
+  worker_context *context;
+  /**
+   * @brief The next waiter in the queue.
+   */
+  sync_waiter *next;
+};
+
+/**
+ * @brief Reschedule every waiter in a (null terminated) chain.
+ */
+inline void sync_resume_all(sync_waiter *head) {
+  while (head != nullptr) {
+    // Cannot touch `head` after it has been scheduled as the task may have been resumed.
+    sync_waiter *next = head->next;
+    LF_LOG("Resuming a task waiting on a sync primitive");
+    non_null(head->context)->schedule(head->handle);
+    head = next;
+  }
+}
+
+/**
+ * @brief A FIFO of waiters, not thread-safe.
+ */
+class sync_queue {
+ public:
+  /**
+   * @brief Check if the queue is empty.
+   */
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_head == nullptr; }
+
+  /**
+   * @brief Peek at the waiter at the front of the queue, ``nullptr`` if the queue is empty.
+   */
+  [[nodiscard]] auto front() const noexcept -> sync_waiter * { return m_head; }
+
+  /**
+   * @brief Add a waiter to the back of the queue.
+   */
+  void push(sync_waiter *waiter) noexcept {
+
+    non_null(waiter)->next = nullptr;
+
+    if (m_tail) {
+      m_tail->next = waiter;
+    } else {
+      m_head = waiter;
+    }
+
+    m_tail = waiter;
+  }
+
+  /**
+   * @brief Remove the waiter at the front of the queue, ``nullptr`` if the queue is empty.
+   */
+  auto pop() noexcept -> sync_waiter * {
+
+    sync_waiter *waiter = m_head;
+
+    if (waiter != nullptr) {
+      m_head = waiter->next;
+      m_tail = m_head ? m_tail : nullptr;
+      waiter->next = nullptr;
+    }
+
+    return waiter;
+  }
+
+  /**
+   * @brief Remove every waiter, returns the (null terminated) chain in FIFO order.
+   */
+  auto pop_all() noexcept -> sync_waiter * {
+    sync_waiter *head = m_head;
+    m_head = m_tail = nullptr;
+    return head;
+  }
+
+ private:
+  sync_waiter *m_head = nullptr;
+  sync_waiter *m_tail = nullptr;
+};
+
+/**
+ * @brief A minimal spin-lock guarding the state of a sync primitive.
+ *
+ * Critical sections are a handful of instructions and never schedule, hence spinning is cheaper
+ * than a `std::mutex` (which could put a worker to sleep).
+ */
+class sync_spinlock {
+ public:
+  /**
+   * @brief Acquire the lock.
+   */
+  void lock() noexcept {
+    while (m_flag.test_and_set(std::memory_order_acquire)) {
+      while (m_flag.test(std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+  /**
+   * @brief Release the lock.
+   */
+  void unlock() noexcept { m_flag.clear(std::memory_order_release); }
+
+ private:
+  std::atomic_flag m_flag = ATOMIC_FLAG_INIT;
+};
+
+/**
+ * @brief An ``lf::core::context_switcher`` for the sync primitives.
+ *
+ * If ``sync->try_ready(arg)`` fails then the task is suspended with a waiter embedded in the awaitable,
+ * ``sync->suspend(arg, waiter)`` must either enqueue the waiter or reschedule it. ``try_ready`` may
+ * resume other waiters, in which case it is allowed to throw.
+ */
+template <typename Sync>
+class [[nodiscard("This should be immediately co_awaited")]] sync_awaitable {
+ public:
+  /**
+   * @brief Construct an awaitable for `sync`.
+   */
+  sync_awaitable(Sync *sync, std::ptrdiff_t arg) noexcept : m_sync{non_null(sync)}, m_arg{arg} {}
+
+  /**
+   * @brief Move construct, the waiter is only initialized when the task suspends.
+   */
+  sync_awaitable(sync_awaitable &&other) noexcept : m_sync{other.m_sync}, m_arg{other.m_arg} {}
+
+  /**
+   * @brief Skip the suspension if the operation can complete immediately.
+   */
+  auto await_ready() noexcept(noexcept(m_sync->try_ready(m_arg))) -> bool { return m_sync->try_ready(m_arg); }
+
+  /**
+   * @brief Enqueue this task on the primitive.
+   */
+  void await_suspend(submit_handle handle) {
+    m_waiter = {handle, tls::context(), nullptr};
+    m_sync->suspend(m_arg, &m_waiter);
+  }
+
+  /**
+   * @brief A no-op.
+   */
+  static auto await_resume() noexcept -> void {}
+
+ private:
+  Sync *m_sync;
+  std::ptrdiff_t m_arg;
+  sync_waiter m_waiter{};
+};
+
+} // namespace impl
+
+/**
+ * @brief A mutex for tasks, contended locks suspend the task rather than block the worker.
+ *
+ * Ownership is handed directly to the next waiter on unlock (FIFO), the waiter is resumed on the
+ * worker it suspended on. Unlike ``std::mutex`` a task may unlock on a different thread to the one
+ * it locked on.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await mtx.lock();
+ *    LF_DEFER { mtx.unlock(); };
+ *
+ * \endrst
+ */
+class mutex : impl::immovable<mutex> {
+
+  using awaitable = impl::sync_awaitable<mutex>;
+
+  friend awaitable;
+
+  auto try_ready(std::ptrdiff_t /* unused */) noexcept -> bool { return try_lock(); }
+
+  void suspend(std::ptrdiff_t /* unused */, impl::sync_waiter *waiter) {
+    {
+      std::lock_guard guard{m_spin};
+
+      if (m_locked) {
+        m_waiters.push(waiter);
+        return;
+      }
+
+      m_locked = true;
+    }
+    // Unlocked between `try_ready` and here.
+    impl::sync_resume_all(waiter);
+  }
+
+ public:
+  /**
+   * @brief Try to acquire the lock without suspending.
+   */
+  [[nodiscard]] auto try_lock() noexcept -> bool {
+
+    std::lock_guard guard{m_spin};
+
+    if (m_locked) {
+      return false;
+    }
+
+    return m_locked = true;
+  }
+
+  /**
+   * @brief Produce an ``lf::core::context_switcher`` that acquires the lock.
+   */
+  [[nodiscard]] auto lock() noexcept -> awaitable { return {this, 0}; }
+
+  /**
+   * @brief Release the lock, the caller must own the lock.
+   */
+  void unlock() {
+
+    impl::sync_waiter *next = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      LF_ASSERT(m_locked);
+
+      if ((next = m_waiters.pop()) == nullptr) {
+        m_locked = false;
+      }
+    }
+
+    impl::sync_resume_all(next);
+  }
+
+ private:
+  impl::sync_spinlock m_spin;
+  bool m_locked = false;
+  impl::sync_queue m_waiters;
+};
+
+/**
+ * @brief A counting semaphore for tasks, acquiring an unavailable permit suspends the task.
+ */
+class semaphore : impl::immovable<semaphore> {
+
+  using awaitable = impl::sync_awaitable<semaphore>;
+
+  friend awaitable;
+
+  auto try_ready(std::ptrdiff_t /* unused */) noexcept -> bool { return try_acquire(); }
+
+  void suspend(std::ptrdiff_t /* unused */, impl::sync_waiter *waiter) {
+    {
+      std::lock_guard guard{m_spin};
+
+      if (m_count == 0) {
+        m_waiters.push(waiter);
+        return;
+      }
+
+      m_count -= 1;
+    }
+    impl::sync_resume_all(waiter);
+  }
+
+ public:
+  /**
+   * @brief Construct a semaphore with `initial` permits.
+   */
+  explicit semaphore(std::ptrdiff_t initial) noexcept : m_count{initial} { LF_ASSERT(initial >= 0); }
+
+  /**
+   * @brief Try to acquire a permit without suspending.
+   */
+  [[nodiscard]] auto try_acquire() noexcept -> bool {
+
+    std::lock_guard guard{m_spin};
+
+    if (m_count == 0) {
+      return false;
+    }
+
+    m_count -= 1;
+    return true;
+  }
+
+  /**
+   * @brief Produce an ``lf::core::context_switcher`` that acquires a permit.
+   */
+  [[nodiscard]] auto acquire() noexcept -> awaitable { return {this, 0}; }
+
+  /**
+   * @brief Release `update` permits, these are handed directly to waiters (FIFO) if there are any.
+   */
+  void release(std::ptrdiff_t update = 1) {
+
+    LF_ASSERT(update >= 0);
+
+    impl::sync_queue woken;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      for (; update > 0 && !m_waiters.empty(); --update) {
+        woken.push(m_waiters.pop());
+      }
+
+      m_count += update;
+    }
+
+    impl::sync_resume_all(woken.pop_all());
+  }
+
+ private:
+  impl::sync_spinlock m_spin;
+  std::ptrdiff_t m_count;
+  impl::sync_queue m_waiters;
+};
+
+/**
+ * @brief A single-use counter for tasks, waiting on a non-zero count suspends the task.
+ */
+class latch : impl::immovable<latch> {
+
+  using awaitable = impl::sync_awaitable<latch>;
+
+  friend awaitable;
+
+  /**
+   * @brief The last arrival completes without suspending, it only has to wake the others.
+   */
+  auto try_ready(std::ptrdiff_t update) -> bool {
+
+    if (update == 0) {
+      return try_wait();
+    }
+
+    impl::sync_waiter *woken = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      LF_ASSERT(m_count >= update);
+
+      if (m_count != update) {
+        return false;
+      }
+
+      m_count = 0;
+      woken = m_waiters.pop_all();
+    }
+
+    impl::sync_resume_all(woken);
+    return true;
+  }
+
+  void suspend(std::ptrdiff_t update, impl::sync_waiter *waiter) {
+
+    impl::sync_waiter *woken = waiter;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      LF_ASSERT(m_count >= update);
+
+      if ((m_count -= update) > 0) {
+        m_waiters.push(waiter);
+        return;
+      }
+
+      if (update > 0) {
+        // Arrived last (after `try_ready` failed), wake everyone including ourselves.
+        m_waiters.push(waiter);
+        woken = m_waiters.pop_all();
+      }
+    }
+
+    impl::sync_resume_all(woken);
+  }
+
+ public:
+  /**
+   * @brief Construct a latch with an initial count of `expected`.
+   */
+  explicit latch(std::ptrdiff_t expected) noexcept : m_count{expected} { LF_ASSERT(expected >= 0); }
+
+  /**
+   * @brief Decrement the count by `update`, if it reaches zero all waiters are resumed.
+   */
+  void count_down(std::ptrdiff_t update = 1) {
+
+    impl::sync_waiter *woken = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      LF_ASSERT(update >= 0 && m_count >= update);
+
+      if ((m_count -= update) == 0) {
+        woken = m_waiters.pop_all();
+      }
+    }
+
+    impl::sync_resume_all(woken);
+  }
+
+  /**
+   * @brief Test if the count has reached zero.
+   */
+  [[nodiscard]] auto try_wait() noexcept -> bool {
+    std::lock_guard guard{m_spin};
+    return m_count == 0;
+  }
+
+  /**
+   * @brief Produce an ``lf::core::context_switcher`` that waits for the count to reach zero.
+   */
+  [[nodiscard]] auto wait() noexcept -> awaitable { return {this, 0}; }
+
+  /**
+   * @brief Produce an ``lf::core::context_switcher`` that decrements the count by `update` then waits.
+   */
+  [[nodiscard]] auto arrive_and_wait(std::ptrdiff_t update = 1) noexcept -> awaitable {
+    LF_ASSERT(update >= 0);
+    return {this, update};
+  }
+
+ private:
+  impl::sync_spinlock m_spin;
+  std::ptrdiff_t m_count;
+  impl::sync_queue m_waiters;
+};
+
+/**
+ * @brief A reusable barrier for tasks, for bulk-synchronous (BSP) style phases.
+ *
+ * Each phase completes when `expected` tasks have arrived, all the tasks suspended in the phase are then
+ * resumed and the barrier resets for the next phase.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    for (int step = 0; step < steps; ++step) {
+ *      compute(step);
+ *      co_await bar.arrive_and_wait();
+ *    }
+ *
+ * \endrst
+ */
+class barrier : impl::immovable<barrier> {
+
+  using awaitable = impl::sync_awaitable<barrier>;
+
+  friend awaitable;
+
+  /**
+   * @brief The arrival that completes the phase does not suspend, it only has to wake the others.
+   */
+  auto try_ready(std::ptrdiff_t /* unused */) -> bool {
+
+    impl::sync_waiter *woken = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      if (m_pending > 1) {
+        return false;
+      }
+
+      // This arrival completes the phase.
+      impl::ignore_t{} = arrive();
+      woken = m_waiters.pop_all();
+    }
+
+    impl::sync_resume_all(woken);
+    return true;
+  }
+
+  void suspend(std::ptrdiff_t /* unused */, impl::sync_waiter *waiter) {
+
+    impl::sync_waiter *woken = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      m_waiters.push(waiter);
+
+      if (arrive()) {
+        woken = m_waiters.pop_all();
+      }
+    }
+
+    impl::sync_resume_all(woken);
+  }
+
+  /**
+   * @brief Arrive at the current phase, returns true if this completed the phase.
+   */
+  auto arrive() noexcept -> bool {
+
+    LF_ASSERT(m_pending > 0);
+
+    if (--m_pending > 0) {
+      return false;
+    }
+
+    m_pending = m_expected;
+    return true;
+  }
+
+ public:
+  /**
+   * @brief Construct a barrier for `expected` tasks.
+   */
+  explicit barrier(std::ptrdiff_t expected) noexcept : m_expected{expected}, m_pending{expected} {
+    LF_ASSERT(expected > 0);
+  }
+
+  /**
+   * @brief Produce an ``lf::core::context_switcher`` that arrives at the current phase then waits for it
+   * to complete.
+   */
+  [[nodiscard]] auto arrive_and_wait() noexcept -> awaitable { return {this, 0}; }
+
+  /**
+   * @brief Arrive at the current phase and decrement the expected count for subsequent phases.
+   */
+  void arrive_and_drop() {
+
+    impl::sync_waiter *woken = nullptr;
+
+    {
+      std::lock_guard guard{m_spin};
+
+      LF_ASSERT(m_expected > 0);
+
+      m_expected -= 1;
+
+      if (arrive()) {
+        woken = m_waiters.pop_all();
+      }
+    }
+
+    impl::sync_resume_all(woken);
+  }
+
+ private:
+  impl::sync_spinlock m_spin;
+  std::ptrdiff_t m_expected;
+  std::ptrdiff_t m_pending;
+  impl::sync_queue m_waiters;
+};
+
+static_assert(context_switcher<impl::sync_awaitable<mutex>>);
+static_assert(context_switcher<impl::sync_awaitable<barrier>>);
+
+} // namespace lf
+
+#endif /* A4D9E2B7_6C1F_4E38_B05A_8F3C7D1E9246 */
@@ -0,0 +1,315 @@
+#ifndef E3A1C7F4_92B5_4D0E_8C61_7B4F2D9A05E8
+#define E3A1C7F4_92B5_4D0E_8C61_7B4F2D9A05E8
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>    // for atomic_flag, memory_order_acquire, memory_order_release
+#include <chrono>    // for steady_clock, duration, time_point, ceil
+#include <semaphore> // for counting_semaphore
+#include <thread>    // for thread
+#include <utility>   // for swap
+
+#include "libfork/core/ext/context.hpp"          // for worker_context
+#include "libfork/core/ext/handles.hpp"          // for submit_handle
+#include "libfork/core/ext/list.hpp"             // for intrusive_list, for_each_elem
+#include "libfork/core/impl/manual_lifetime.hpp" // for manual_lifetime
+#include "libfork/core/impl/utility.hpp"         // for immovable, non_null
+#include "libfork/core/invocable.hpp"            // for ignore_t
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_LOG
+#include "libfork/core/scheduler.hpp"            // for scheduler, context_switcher
+
+/**
+ * @file timer.hpp
+ *
+ * @brief Context switchers that resume a task on a scheduler after a deadline.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief The clock used by all timers.
+ */
+using timer_clock = std::chrono::steady_clock;
+
+/**
+ * @brief A pending timer, submitted to the timer thread.
+ */
+struct timer_entry {
+  /**
+   * @brief The time after which the task should be resumed.
+   */
+  timer_clock::time_point deadline;
+  /**
+   * @brief The suspended task.
+   */
+  submit_handle handle;
+  /**
+   * @brief The (type erased) scheduler to resume the task on.
+   */
+  void *dest;
+  /**
+   * @brief Calls `dest->schedule(handle)` with `dest` cast back to its real type.
+   */
+  void (*schedule)(void *dest, submit_handle handle);
+  /**
+   * @brief The first child of this entry in the timer thread's heap.
+   */
+  timer_entry *child = nullptr;
+  /**
+   * @brief The next sibling of this entry in the timer thread's heap.
+   */
+  timer_entry *sibling = nullptr;
+};
+
+/**
+ * @brief A node in the timer thread's submission list, embedded in the suspended task's frame.
+ */
+using timer_node = intrusive_list<timer_entry>::node;
+
+/**
+ * @brief A dedicated thread that resumes suspended tasks once their deadline has passed.
+ *
+ * Submitting a timer is lock-free and allocates no memory hence, workers never block. The timer
+ * thread keeps an (intrusive, pairing) min-heap of the pending timers and sleeps until the earliest
+ * deadline or a new submission, whichever comes first. The heap is threaded through the entries hence,
+ * the timer thread never allocates either.
+ */
+class timer_thread : immovable<timer_thread> {
+ public:
+  /**
+   * @brief Start the timer thread.
+   */
+  timer_thread() : m_thread{[this] { loop(); }} {}
+
+  /**
+   * @brief Submit a timer, this can be called concurrently from any number of threads.
+   *
+   * The node must remain valid until its entry's handle has been scheduled.
+   */
+  void submit(timer_node *node) noexcept {
+    m_submit.push(non_null(node));
+    m_wake.release();
+  }
+
+  /**
+   * @brief Stop the thread, pending timers are abandoned.
+   */
+  ~timer_thread() noexcept {
+    m_stop.test_and_set(std::memory_order_release);
+    m_wake.release();
+    m_thread.join();
+  }
+
+ private:
+  /**
+   * @brief Merge two heaps, the root with the earliest deadline adopts the other.
+   */
+  static auto meld(timer_entry *lhs, timer_entry *rhs) noexcept -> timer_entry * {
+
+    if (lhs == nullptr) {
+      return rhs;
+    }
+
+    if (rhs == nullptr) {
+      return lhs;
+    }
+
+    if (rhs->deadline < lhs->deadline) {
+      std::swap(lhs, rhs);
+    }
+
+    rhs->sibling = lhs->child;
+    lhs->child = rhs;
+
+    return lhs;
+  }
+
+  /**
+   * @brief Remove the root of a non-empty heap, returns the new root.
+   *
+   * This is the standard two-pass merge of the root's children, done iteratively.
+   */
+  static auto pop(timer_entry *root) noexcept -> timer_entry * {
+
+    timer_entry *pairs = nullptr;
+
+    // Left to right, meld adjacent children and push the pairs onto a stack (reusing `sibling`).
+    for (timer_entry *head = root->child; head != nullptr;) {
+
+      timer_entry *lhs = head;
+      timer_entry *rhs = lhs->sibling;
+
+      head = rhs ? rhs->sibling : nullptr;
+
+      lhs->sibling = nullptr;
+
+      if (rhs != nullptr) {
+        rhs->sibling = nullptr;
+      }
+
+      timer_entry *pair = meld(lhs, rhs);
+      pair->sibling = pairs;
+      pairs = pair;
+    }
+
+    // Right to left, meld the pairs into one heap.
+    timer_entry *heap = nullptr;
+
+    while (pairs != nullptr) {
+      timer_entry *next = pairs->sibling;
+      pairs->sibling = nullptr;
+      heap = meld(heap, pairs);
+      pairs = next;
+    }
+
+    return heap;
+  }
+
+  void loop() noexcept {
+
+    timer_entry *heap = nullptr;
+
+    while (!m_stop.test(std::memory_order_acquire)) {
+
+      for_each_elem(m_submit.try_pop_all(), [&](timer_entry &entry) {
+        entry.child = entry.sibling = nullptr;
+        heap = meld(heap, &entry);
+      });
+
+      auto now = timer_clock::now();
+
+      while (heap != nullptr && heap->deadline <= now) {
+
+        timer_entry entry = *heap;
+        heap = pop(heap);
+
+        LF_LOG("Timer expired, rescheduling task");
+
+        // Cannot touch the node after this as the task may have been resumed.
+        entry.schedule(entry.dest, entry.handle);
+      }
+
+      if (heap == nullptr) {
+        m_wake.acquire();
+      } else {
+        ignore_t{} = m_wake.try_acquire_until(heap->deadline);
+      }
+    }
+  }
+
+  intrusive_list<timer_entry> m_submit;
+  std::counting_semaphore<> m_wake{0};
+  std::atomic_flag m_stop = ATOMIC_FLAG_INIT;
+  std::thread m_thread;
+};
+
+/**
+ * @brief Get the process-wide timer thread, started on first use.
+ */
+inline auto timers() -> timer_thread & {
+  static timer_thread instance;
+  return instance;
+}
+
+} // namespace impl
+
+template <scheduler Sch>
+class resume_at_quasi_awaitable;
+
+/**
+ * @brief Create an ``lf::core::context_switcher`` to transfer execution to ``dest`` at/after ``deadline``.
+ *
+ * The awaiting task gives up its worker (and stack) while suspended, no worker ever sleeps on the timer.
+ * If the deadline has already passed then the task is not suspended and continues on its current worker.
+ * `dest` must be non-null.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await lf::resume_at(&pool, std::chrono::steady_clock::now() + 5ms);
+ *
+ * \endrst
+ */
+template <scheduler Sch>
+auto resume_at(Sch *dest, std::chrono::steady_clock::time_point deadline) noexcept
+    -> resume_at_quasi_awaitable<Sch> {
+  return resume_at_quasi_awaitable<Sch>{impl::non_null(dest), deadline};
+}
+
+/**
+ * @brief Create an ``lf::core::context_switcher`` to transfer execution to ``dest`` after ``delay``.
+ *
+ * Equivalent to ``lf::resume_at(dest, std::chrono::steady_clock::now() + delay)``.
+ */
+template <scheduler Sch, typename Rep, typename Period>
+auto resume_after(Sch *dest, std::chrono::duration<Rep, Period> delay) noexcept
+    -> resume_at_quasi_awaitable<Sch> {
+  return resume_at(dest, impl::timer_clock::now() + std::chrono::ceil<impl::timer_clock::duration>(delay));
+}
+
+/**
+ * @brief An ``lf::core::context_switcher`` that transfers execution to a scheduler after a deadline.
+ */
+template <scheduler Sch>
+class [[nodiscard("This should be immediately co_awaited")]] resume_at_quasi_awaitable {
+
+  Sch *m_dest;
+  std::chrono::steady_clock::time_point m_deadline;
+  impl::manual_lifetime<impl::timer_node> m_node;
+
+  resume_at_quasi_awaitable(Sch *dest, std::chrono::steady_clock::time_point deadline) noexcept
+      : m_dest{dest},
+        m_deadline{deadline} {}
+
+  friend auto resume_at<Sch>(Sch *dest, std::chrono::steady_clock::time_point deadline) noexcept
+      -> resume_at_quasi_awaitable;
+
+ public:
+  /**
+   * @brief Move construct, the timer node is only constructed when the task suspends.
+   */
+  resume_at_quasi_awaitable(resume_at_quasi_awaitable &&other) noexcept
+      : m_dest{other.m_dest},
+        m_deadline{other.m_deadline} {}
+
+  /**
+   * @brief Don't suspend if the deadline has passed.
+   */
+  auto await_ready() const noexcept -> bool { return m_deadline <= impl::timer_clock::now(); }
+
+  /**
+   * @brief Hand this coroutine to the timer thread.
+   */
+  void await_suspend(submit_handle handle) {
+
+    auto &timers = impl::timers();
+
+    constexpr auto schedule = [](void *dest, submit_handle due) {
+      static_cast<Sch *>(dest)->schedule(due);
+    };
+
+    timers.submit(m_node.construct(impl::timer_entry{m_deadline, handle, m_dest, schedule}));
+  }
+
+  /**
+   * @brief A no-op.
+   */
+  static auto await_resume() noexcept -> void {}
+};
+
+static_assert(context_switcher<resume_at_quasi_awaitable<worker_context>>);
+
+} // namespace lf
+
+#endif /* E3A1C7F4_92B5_4D0E_8C61_7B4F2D9A05E8 */
@@ -0,0 +1,153 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, ranges::copy_if, ranges::remove_if, ...
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for operator==, INTERNAL_CATCH_...
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <iterator>                              // for back_inserter, ssize
+#include <span>                                  // for span
+#include <stdexcept>                             // for runtime_error
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/filter.hpp" // for copy_if, remove_if, partition, stable_partition
+#include "libfork/core.hpp"             // for sync_wait
+#include "libfork/schedule.hpp"         // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+template <typename Sch>
+void test(Sch &&sch) {
+
+  auto even = [](int x) {
+    return x % 2 == 0;
+  };
+
+  std::span<int> oops;
+
+  REQUIRE(sync_wait(sch, lf::copy_if, oops, oops.begin(), even) == oops.begin());
+  REQUIRE(sync_wait(sch, lf::remove_if, oops, 10, even) == oops.end());
+  REQUIRE(sync_wait(sch, lf::partition, oops.begin(), oops.end(), even) == oops.end());
+  REQUIRE(sync_wait(sch, lf::stable_partition, oops, even) == oops.end());
+
+  for (int len : {1, 2, 3, 10, 100, 1'000, 20'000}) {
+    for (std::ptrdiff_t m : {1, 3, 100, 5'000}) {
+
+      std::vector<int> v;
+
+      for (int i = 0; i < len; ++i) {
+        v.push_back(i * 7919 % 1'009);
+      }
+
+      // copy_if
+
+      std::vector<int> expect;
+      std::ranges::copy_if(v, std::back_inserter(expect), even);
+
+      std::vector<int> out(v.size());
+
+      auto end = sync_wait(sch, lf::copy_if, v.begin(), v.end(), out.begin(), m, even);
+
+      REQUIRE(end - out.begin() == std::ssize(expect));
+      out.erase(end, out.end());
+      REQUIRE(out == expect);
+
+      // remove_if
+
+      auto w = v;
+      auto kept = sync_wait(sch, lf::remove_if, w, m, even);
+
+      auto x = v;
+      x.erase(std::ranges::remove_if(x, even).begin(), x.end());
+
+      REQUIRE(kept - w.begin() == std::ssize(x));
+      w.erase(kept, w.end());
+      REQUIRE(w == x);
+
+      // stable_partition
+
+      auto s = v;
+      auto s_mid = sync_wait(sch, lf::stable_partition, s.begin(), s.end(), m, even);
+
+      auto t = v;
+      auto t_mid = std::ranges::stable_partition(t, even).begin();
+
+      REQUIRE(s_mid - s.begin() == t_mid - t.begin());
+      REQUIRE(s == t);
+
+      // partition
+
+      auto p = v;
+      auto p_mid = sync_wait(sch, lf::partition, p, m, even);
+
+      REQUIRE(p_mid - p.begin() == t_mid - t.begin());
+      REQUIRE(std::ranges::is_partitioned(p, even));
+      std::ranges::sort(p);
+      std::ranges::sort(t);
+      REQUIRE(p == t);
+    }
+  }
+
+  // Projections and a type that is not trivially copyable.
+  std::vector<std::string> s;
+
+  for (int i = 0; i < 10'000; ++i) {
+    s.push_back(std::to_string(i));
+  }
+
+  auto expect = s;
+  auto expect_mid = std::ranges::stable_partition(expect, even, &std::string::size).begin();
+
+  auto mid = sync_wait(sch, lf::stable_partition, s, 100, even, &std::string::size);
+
+  REQUIRE(mid - s.begin() == expect_mid - expect.begin());
+  REQUIRE(s == expect);
+
+  auto removed = sync_wait(sch, lf::remove_if, s, 100, even, &std::string::size);
+
+  REQUIRE(removed - s.begin() == expect.end() - expect_mid);
+  REQUIRE(std::ranges::equal(s.begin(), removed, expect_mid, expect.end()));
+
+  std::vector<int> v(10'000, 1);
+
+  v[5'000] = 42;
+
+  auto thrower = [](int x) -> bool {
+    if (x == 42) {
+      throw std::runtime_error{"filter"};
+    }
+    return x % 2 == 0;
+  };
+
+  REQUIRE_THROWS_AS(sync_wait(sch, lf::copy_if, v, v.begin(), 100, thrower), std::runtime_error);
+  REQUIRE_THROWS_AS(sync_wait(sch, lf::partition, v, 100, thrower), std::runtime_error);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("filter", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+  test(make_scheduler<TestType>());
+}
+
+// NOLINTEND
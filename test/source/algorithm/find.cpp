@@ -0,0 +1,166 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, ranges::find_if, ranges::mismatch
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for operator==, INTERNAL_CATCH_...
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <span>                                  // for span
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/find.hpp" // for find_if, any_of, all_of, none_of, mismatch, equal
+#include "libfork/core.hpp"           // for sync_wait
+#include "libfork/schedule.hpp"       // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+/**
+ * @brief A predicate that flags if the same copy is invoked concurrently.
+ */
+struct exclusive_neg {
+
+  explicit exclusive_neg(std::atomic<bool> *flag) : overlap{flag} {}
+
+  exclusive_neg(exclusive_neg const &other) : overlap{other.overlap} {}
+
+  auto operator()(int x) -> bool {
+    if (inside.exchange(true)) {
+      *overlap = true;
+    }
+    std::this_thread::yield();
+    inside = false;
+    return x < 0;
+  }
+
+  std::atomic<bool> *overlap;
+  std::atomic<bool> inside = false;
+};
+
+template <typename Sch>
+void test(Sch &&sch) {
+
+  auto is_neg = [](int x) {
+    return x < 0;
+  };
+
+  auto is_pos = [](int x) {
+    return x >= 0;
+  };
+
+  std::span<int> oops;
+
+  REQUIRE(sync_wait(sch, lf::find_if, oops, is_neg) == oops.end());
+  REQUIRE(!sync_wait(sch, lf::any_of, oops, is_neg));
+  REQUIRE(sync_wait(sch, lf::all_of, oops, is_neg));
+  REQUIRE(sync_wait(sch, lf::none_of, oops, is_neg));
+  REQUIRE(sync_wait(sch, lf::equal, oops, oops));
+
+  for (int len : {1, 2, 3, 10, 1'000, 20'000}) {
+
+    std::vector<int> v(static_cast<std::size_t>(len), 1);
+
+    // Several matches, the first must win.
+    for (int first : {0, len / 3, len - 1}) {
+
+      std::vector<int> w = v;
+
+      for (int i = first; i < len; i += 7) {
+        w[static_cast<std::size_t>(i)] = -1;
+      }
+
+      auto expect = std::ranges::find_if(w, is_neg);
+
+      REQUIRE(sync_wait(sch, lf::find_if, w, is_neg) == expect);
+      REQUIRE(sync_wait(sch, lf::find_if, w.begin(), w.end(), is_neg) == expect);
+
+      for (int n : {1, 3, 100, 5'000}) {
+        REQUIRE(sync_wait(sch, lf::find_if, w, n, is_neg) == expect);
+        REQUIRE(sync_wait(sch, lf::find_if, w.begin(), w.end(), n, is_neg) == expect);
+        REQUIRE(sync_wait(sch, lf::any_of, w, n, is_neg));
+        REQUIRE(!sync_wait(sch, lf::all_of, w, n, is_pos));
+        REQUIRE(!sync_wait(sch, lf::none_of, w.begin(), w.end(), n, is_neg));
+
+        auto [it1, it2] = sync_wait(sch, lf::mismatch, v, w, n);
+
+        REQUIRE(it1 == v.begin() + (expect - w.begin()));
+        REQUIRE(it2 == expect);
+        REQUIRE(!sync_wait(sch, lf::equal, v.begin(), v.end(), w.begin(), w.end(), n));
+      }
+    }
+
+    // No match.
+    for (int n : {1, 3, 100, 5'000}) {
+      REQUIRE(sync_wait(sch, lf::find_if, v, n, is_neg) == v.end());
+      REQUIRE(!sync_wait(sch, lf::any_of, v, n, is_neg));
+      REQUIRE(sync_wait(sch, lf::all_of, v, n, is_pos));
+      REQUIRE(sync_wait(sch, lf::none_of, v, n, is_neg));
+      REQUIRE(sync_wait(sch, lf::equal, v, v, n));
+    }
+
+    // With a projection.
+    REQUIRE(sync_wait(sch, lf::all_of, v, 10, is_neg, [](int x) {
+      return -x;
+    }));
+
+    // Different lengths, mismatch stops at the shorter.
+    std::vector<int> u(v.size() + 1, 1);
+
+    auto [it1, it2] = sync_wait(sch, lf::mismatch, v.begin(), v.end(), u.begin(), u.end());
+
+    REQUIRE(it1 == v.end());
+    REQUIRE(it2 == u.begin() + len);
+    REQUIRE(!sync_wait(sch, lf::equal, v, u));
+  }
+
+  std::vector<int> v(10'000, 1);
+
+  v[5'000] = 42;
+
+  auto thrower = [](int x) -> bool {
+    if (x == 42) {
+      throw std::runtime_error{"find_if"};
+    }
+    return false;
+  };
+
+  REQUIRE_THROWS_AS(sync_wait(sch, lf::find_if, v, 100, thrower), std::runtime_error);
+  REQUIRE_THROWS_AS(sync_wait(sch, lf::any_of, v, 100, thrower), std::runtime_error);
+
+  // Each copy of the predicate must only be invoked by one task at a time.
+  std::atomic<bool> overlap = false;
+
+  std::vector<int> u(2'000, 1);
+
+  REQUIRE(!sync_wait(sch, lf::any_of, u, 10, exclusive_neg{&overlap}));
+  REQUIRE(!overlap);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("find", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+  test(make_scheduler<TestType>());
+}
+
+// NOLINTEND
@@ -9,13 +9,15 @@
 // #define NDEBUG
 // #define LF_COROUTINE_OFFSET 2 * sizeof(void *)
 
-#include <algorithm>                             // for min
+#include <algorithm>                             // for min, ranges::max_element, ranges::min_element
 #include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
 #include <catch2/catch_test_macros.hpp>          // for operator==, operator<=, INTERNAL_CATCH_...
 #include <concepts>                              // for constructible_from
 #include <cstddef>                               // for size_t
+#include <cstdint>                               // for int64_t
 #include <functional>                            // for multiplies, identity, plus
 #include <initializer_list>                      // for initializer_list
+#include <limits>                                // for numeric_limits
 #include <numeric>                               // for reduce
 #include <optional>                              // for operator==, nullopt
 #include <span>                                  // for span
@@ -25,7 +27,7 @@
 #include <vector>                                // for vector
 
 #include "libfork/algorithm/fold.hpp" // for fold
-#include "libfork/core.hpp"           // for sync_wait, task, just
+#include "libfork/core.hpp"           // for sync_wait, schedule, task, just, request_stop
 #include "libfork/schedule.hpp"       // for busy_pool, lazy_pool, unit_pool
 #include "matrix.hpp"                 // for matrix, operator*, random_vec
 
@@ -86,6 +88,14 @@ void test(Sch &&sch, F sum, Proj proj = {}) {
     REQUIRE(lf::sync_wait(sch, lf::fold, v.begin(), v.end(), m, sum, doubler(proj)) == 2 * correct);
   }
 
+  // Lazy binary splitting:
+  REQUIRE(lf::sync_wait(sch, lf::fold, oops, lf::lazy_split, sum, proj) == std::nullopt);
+
+  for (auto lazy : {lf::lazy_split, lf::lazy_split_t{1}, lf::lazy_split_t{300}}) {
+    REQUIRE(lf::sync_wait(sch, lf::fold, v, lazy, sum, proj) == correct);
+    REQUIRE(lf::sync_wait(sch, lf::fold, v.begin(), v.end(), lazy, sum, doubler(proj)) == 2 * correct);
+  }
+
 #ifndef _MSC_VER
 
   // ----------- Now with small inputs ----------- //
@@ -140,6 +150,109 @@ TEMPLATE_TEST_CASE("fold non-commuting", "[algorithm][template]", unit_pool, bus
       matrix ngv = std::reduce(in.begin(), in.end(), matrix{1, 0, 0, 1}, std::multiplies<>{});
 
       REQUIRE(ngv == lf::sync_wait(sch, lf::fold, in, chunk, std::multiplies<>{}));
+      REQUIRE(ngv == lf::sync_wait(sch, lf::fold, in, lf::lazy_split_t{chunk}, std::multiplies<>{}));
     }
   }
 }
+
+namespace {
+
+template <typename T, typename Sch>
+void test_known_ops(Sch &&sch) {
+
+  std::vector<T> v;
+
+  for (int i = 0; i < 5'003; ++i) {
+    v.push_back(static_cast<T>((i * 7'919) % 61));
+  }
+
+  T sum = std::reduce(v.begin(), v.end(), T{});
+  auto wide = std::reduce(v.begin(), v.end(), T{} + T{}); // Promoted by std::plus<>
+  T low = *std::ranges::min_element(v);
+  T top = *std::ranges::max_element(v);
+
+  // Lengths that are not a multiple of the number of lanes.
+  for (int m : {2, 3, 17, 1'000, 10'000}) {
+    REQUIRE(lf::sync_wait(sch, lf::fold, v, m, std::plus<>{}) == wide);
+    REQUIRE(lf::sync_wait(sch, lf::fold, v, m, std::plus<T>{}) == sum);
+    REQUIRE(lf::sync_wait(sch, lf::fold, v, m, std::ranges::min) == low);
+    REQUIRE(lf::sync_wait(sch, lf::fold, v, m, std::ranges::max) == top);
+    REQUIRE(lf::sync_wait(sch, lf::fold, v, lf::lazy_split_t{m}, std::plus<T>{}) == sum);
+  }
+
+  std::vector<T> ones(3'001, T{1});
+
+  ones[1'234] = T{3};
+
+  REQUIRE(lf::sync_wait(sch, lf::fold, ones, 100, std::multiplies<>{}) == T{3});
+}
+
+/**
+ * @brief `std::ranges::min/max` skip a NaN unless it is the accumulator, one chunk must match a serial fold.
+ */
+template <typename T, typename Sch>
+void test_unordered(Sch &&sch) {
+
+  std::vector<T> v(100, T{0});
+
+  // All in the same lane, if the NaN led a lane it would swallow the extrema.
+  v[1] = std::numeric_limits<T>::quiet_NaN();
+  v[17] = T{5};
+  v[33] = T{-5};
+
+  REQUIRE(lf::sync_wait(sch, lf::fold, v, 100, std::ranges::max) == T{5});
+  REQUIRE(lf::sync_wait(sch, lf::fold, v, 100, std::ranges::min) == T{-5});
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("fold known operators", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  test_known_ops<int>(sch);
+  test_known_ops<unsigned char>(sch);
+  test_known_ops<std::int64_t>(sch);
+  test_known_ops<float>(sch);
+  test_known_ops<double>(sch);
+
+  test_unordered<float>(sch);
+  test_unordered<double>(sch);
+}
+
+namespace {
+
+inline constexpr auto stop_then_fold = [](auto, std::span<int const> v) -> task<std::optional<int>> {
+  //
+  co_await lf::request_stop();
+
+  std::optional<int> out;
+
+  co_await lf::call(&out, lf::fold)(v, 1, std::plus<>{});
+  co_await lf::join;
+
+  co_return out;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("fold cancelled", "[algorithm][cancel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  constexpr int n = 10'000;
+
+  std::vector<int> v(n, 1);
+
+  // Forks with a return address are never elided hence, a cancelled fold still completes.
+  REQUIRE(lf::sync_wait(sch, stop_then_fold, std::span<int const>{v}) == n);
+
+  for (int i = 0; i < 10; ++i) {
+
+    auto fut = lf::schedule(sch, lf::fold, v, 1, std::plus<>{});
+
+    fut.request_stop();
+
+    REQUIRE(fut.get() == n);
+  }
+}
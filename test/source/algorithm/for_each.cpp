@@ -10,6 +10,7 @@
 // #define LF_COROUTINE_OFFSET 2 * sizeof(void *)
 
 #include <algorithm>                             // for min
+#include <atomic>                                // for atomic
 #include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
 #include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
 #include <concepts>                              // for constructible_from
@@ -20,9 +21,10 @@
 #include <utility>                               // for forward
 #include <vector>                                // for vector, allocator, operator==
 
-#include "libfork/algorithm/for_each.hpp" // for for_each
-#include "libfork/core.hpp"               // for sync_wait, task
-#include "libfork/schedule.hpp"           // for busy_pool, lazy_pool, unit_pool
+#include "libfork/algorithm/blocked_range.hpp" // for blocked_range, blocked_range2d, blocked_range3d
+#include "libfork/algorithm/for_each.hpp"      // for for_each
+#include "libfork/core.hpp"                    // for sync_wait, task
+#include "libfork/schedule.hpp"                // for busy_pool, lazy_pool, unit_pool
 
 // NOLINTBEGIN No linting in tests
 
@@ -79,6 +81,16 @@ void test(Sch &&sch, F add_one, Proj proj = {}) {
     REQUIRE(v.size() < 20'000);
     lf::sync_wait(sch, lf::for_each, v, 20'000, add_one);
     check(v, count++);
+
+    // Lazy binary splitting, default and small chunks:
+    lf::sync_wait(sch, lf::for_each, v, lf::lazy_split, add_one, proj);
+    check(v, count++);
+
+    lf::sync_wait(sch, lf::for_each, v, lf::lazy_split_t{1}, add_one, proj);
+    check(v, count++);
+
+    lf::sync_wait(sch, lf::for_each, v.begin(), v.end(), lf::lazy_split_t{300}, add_one);
+    check(v, count++);
   }
 
 #ifndef _MSC_VER
@@ -120,8 +132,70 @@ constexpr auto coro_identity = []<typename T>(auto, T &&val) -> task<T &&> {
   co_return std::forward<T>(val);
 };
 
+std::atomic<int> tiles_seen = 0;
+
+constexpr auto count_unit_tiles = [](auto, blocked_range<2> tile) -> task<> {
+  if (tile.extent(0) == 1 && tile.extent(1) == 1) {
+    tiles_seen += 1;
+  }
+  co_return;
+};
+
+template <typename Sch>
+void test_blocked(Sch &&sch) {
+
+  constexpr int nx = 37;
+  constexpr int ny = 50;
+  constexpr int nz = 23;
+
+  std::vector<int> grid(nx * ny * nz, 0);
+
+  std::atomic<bool> too_big = false;
+
+  auto visit = [&](blocked_range3d<int> tile) {
+    if (tile.extent(0) > 4 || tile.extent(1) > 8 || tile.extent(2) > 5) {
+      too_big = true;
+    }
+    for (int i : tile.indices(0)) {
+      for (int j : tile.indices(1)) {
+        for (int k : tile.indices(2)) {
+          grid[static_cast<std::size_t>((i * ny + j) * nz + k)] += 1;
+        }
+      }
+    }
+  };
+
+  lf::sync_wait(sch, lf::for_each, blocked_range3d<int>{{0, 0, 0}, {nx, ny, nz}, {4, 8, 5}}, visit);
+
+  REQUIRE(!too_big);
+  REQUIRE(std::ranges::count(grid, 1) == nx * ny * nz);
+
+  // Async function, a sub-box and grain one.
+  tiles_seen = 0;
+
+  lf::sync_wait(sch, lf::for_each, blocked_range<2>{{3, 5}, {9, 17}}, count_unit_tiles);
+
+  REQUIRE(tiles_seen == 6 * 12);
+
+  // Empty boxes do nothing.
+  lf::sync_wait(sch, lf::for_each, blocked_range2d<>{{0, 0}, {0, 10}}, count_unit_tiles);
+
+  REQUIRE(tiles_seen == 6 * 12);
+
+  // Split along the longest divisible dimension.
+  auto [lhs, rhs] = blocked_range2d<>{{0, 0}, {100, 10}, {1, 1}}.split();
+
+  REQUIRE(lhs == blocked_range2d<>{{0, 0}, {50, 10}});
+  REQUIRE(rhs == blocked_range2d<>{{50, 0}, {100, 10}});
+  REQUIRE(!blocked_range2d<>{{0, 0}, {100, 10}, {100, 10}}.is_divisible());
+}
+
 } // namespace
 
+TEMPLATE_TEST_CASE("for each (blocked range)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+  test_blocked(make_scheduler<TestType>());
+}
+
 TEMPLATE_TEST_CASE("for each (reg, reg)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
   test(make_scheduler<TestType>(), add_reg);
 }
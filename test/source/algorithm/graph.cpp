@@ -0,0 +1,222 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <random>                                // for mt19937, uniform_int_distribution
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread
+#include <utility>                               // for pair
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/graph.hpp" // for task_graph, run_graph
+#include "libfork/core.hpp"            // for sync_wait, task
+#include "libfork/schedule.hpp"        // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+/**
+ * @brief A random DAG, edges always go from a lower to a higher index.
+ */
+struct random_dag {
+
+  random_dag(std::size_t n, std::size_t m) : stamps(n) {
+
+    std::mt19937 rng{static_cast<unsigned>(n + m)};
+
+    std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+
+    for (std::size_t i = 0; i < m; ++i) {
+      std::size_t a = dist(rng);
+      std::size_t b = dist(rng);
+      if (a != b) {
+        edges.emplace_back(std::min(a, b), std::max(a, b));
+      }
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+      if (i % 3 == 0) {
+        // An async node.
+        nodes.push_back(graph.emplace([this, i](auto) -> task<> {
+          stamps[i] = ++clock;
+          co_return;
+        }));
+      } else {
+        nodes.push_back(graph.emplace([this, i] {
+          stamps[i] = ++clock;
+        }));
+      }
+    }
+
+    for (auto [a, b] : this->edges) {
+      graph.precede(nodes[a], nodes[b]);
+    }
+  }
+
+  /**
+   * @brief Check every node ran (once) after all its predecessors.
+   */
+  auto check() const -> bool {
+    for (auto &&stamp : stamps) {
+      if (stamp == 0) {
+        return false;
+      }
+    }
+    for (auto [a, b] : edges) {
+      if (stamps[a] >= stamps[b]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void reset() {
+    for (auto &&stamp : stamps) {
+      stamp = 0;
+    }
+  }
+
+  std::atomic<std::size_t> clock = 0;
+  std::vector<std::size_t> stamps;
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  std::vector<task_graph::node> nodes;
+  task_graph graph;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Graph diamond", "[graph][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  task_graph graph;
+
+  std::atomic<int> top = 0;
+  std::atomic<int> left = 0;
+  std::atomic<int> right = 0;
+  std::atomic<int> bottom = 0;
+
+  auto a = graph.emplace([&] {
+    top = 1;
+  });
+
+  auto b = graph.emplace([&](auto) -> task<> {
+    left = top + 1;
+    co_return;
+  });
+
+  auto c = graph.emplace([&] {
+    right = top + 2;
+  });
+
+  auto d = graph.emplace([&] {
+    bottom = left + right;
+  });
+
+  graph.precede(a, b);
+  graph.precede(a, c);
+  graph.precede(b, d);
+  graph.precede(c, d);
+
+  REQUIRE(graph.size() == 4);
+
+  for (int i = 0; i < 10; ++i) {
+    top = left = right = bottom = 0;
+    sync_wait(sch, run_graph, graph);
+    REQUIRE(bottom == 5);
+  }
+
+  task_graph empty;
+
+  sync_wait(sch, run_graph, empty);
+}
+
+TEMPLATE_TEST_CASE("Graph random", "[graph][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t n : {1UZ, 2UZ, 10UZ, 100UZ, 1000UZ}) {
+    for (std::size_t m : {0UZ, n, 4 * n}) {
+
+      random_dag dag{n, m};
+
+      // Graphs are reusable.
+      for (int i = 0; i < 3; ++i) {
+        dag.reset();
+        sync_wait(sch, run_graph, dag.graph);
+        REQUIRE(dag.check());
+      }
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Graph exceptions", "[graph][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  task_graph graph;
+
+  std::atomic<bool> fail = true;
+  std::atomic<int> after = 0;
+  std::atomic<int> beside = 0;
+
+  auto sync_throw = graph.emplace([&] {
+    if (fail) {
+      throw std::runtime_error{"sync"};
+    }
+  });
+
+  auto async_throw = graph.emplace([&](auto) -> task<> {
+    if (fail) {
+      throw std::runtime_error{"async"};
+    }
+    co_return;
+  });
+
+  auto skipped = graph.emplace([&] {
+    after += 1;
+  });
+
+  graph.emplace([&] {
+    beside += 1;
+  });
+
+  graph.precede(sync_throw, skipped);
+  graph.precede(async_throw, skipped);
+
+  REQUIRE_THROWS_AS(sync_wait(sch, run_graph, graph), std::runtime_error);
+
+  REQUIRE(after == 0);
+  REQUIRE(beside == 1);
+
+  fail = false;
+
+  sync_wait(sch, run_graph, graph);
+
+  REQUIRE(after == 1);
+  REQUIRE(beside == 2);
+}
+
+// NOLINTEND
@@ -79,6 +79,16 @@ void test(Sch &&sch, F add_one, Proj proj = {}) {
     REQUIRE(v.size() < 20'000);
     lf::sync_wait(sch, lf::map, v, v.begin(), 20'000, add_one);
     check(v, count++);
+
+    // Lazy binary splitting, default and small chunks:
+    lf::sync_wait(sch, lf::map, v, v.begin(), lf::lazy_split, add_one, proj);
+    check(v, count++);
+
+    lf::sync_wait(sch, lf::map, v, v.begin(), lf::lazy_split_t{1}, add_one, proj);
+    check(v, count++);
+
+    lf::sync_wait(sch, lf::map, v.begin(), v.end(), v.begin(), lf::lazy_split_t{300}, add_one);
+    check(v, count++);
   }
 
 #ifndef _MSC_VER
@@ -0,0 +1,167 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <optional>                              // for optional
+#include <stdexcept>                             // for runtime_error
+#include <string>                                // for string, to_string, stoi
+#include <thread>                                // for thread, yield
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/pipeline.hpp" // for pipeline, stage, stage_mode
+#include "libfork/core.hpp"               // for sync_wait, task
+#include "libfork/schedule.hpp"           // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+/**
+ * @brief Produces 0, 1, ..., n - 1.
+ */
+auto counter(int n) {
+  return [i = 0, n]() mutable -> std::optional<int> {
+    if (i == n) {
+      return std::nullopt;
+    }
+    return i++;
+  };
+}
+
+/**
+ * @brief Detects concurrent calls.
+ */
+struct exclusive {
+
+  void operator()() {
+    if (inside.exchange(true)) {
+      overlap = true;
+    }
+    std::this_thread::yield();
+    inside = false;
+  }
+
+  std::atomic<bool> inside = false;
+  std::atomic<bool> overlap = false;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Pipeline order", "[pipeline][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t tokens : {1UZ, 2UZ, 7UZ, 64UZ}) {
+    for (int n : {0, 1, 10, 1000}) {
+
+      std::vector<int> out;
+      exclusive in_order;
+      exclusive out_of_order;
+      std::atomic<int> count = 0;
+
+      sync_wait(sch,
+                pipeline,
+                tokens,
+                counter(n),
+                stage<stage_mode::parallel>([](int x) {
+                  return std::to_string(x * x);
+                }),
+                stage<stage_mode::serial_out_of_order>([&](std::string x) {
+                  out_of_order();
+                  count += 1;
+                  return std::stoi(x);
+                }),
+                stage<stage_mode::serial_in_order>([&](int x) {
+                  in_order();
+                  out.push_back(x);
+                }));
+
+      REQUIRE(count == n);
+      REQUIRE(!in_order.overlap);
+      REQUIRE(!out_of_order.overlap);
+      REQUIRE(out.size() == static_cast<std::size_t>(n));
+
+      for (int i = 0; i < n; ++i) {
+        REQUIRE(out[static_cast<std::size_t>(i)] == i * i);
+      }
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Pipeline exceptions", "[pipeline][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int bad : {0, 1, 50}) {
+
+    std::vector<int> out;
+
+    auto fail = [bad](int x) {
+      if (x == bad) {
+        throw std::runtime_error{"stage"};
+      }
+      return x;
+    };
+
+    auto write = [&](int x) {
+      out.push_back(x);
+    };
+
+    REQUIRE_THROWS_AS(sync_wait(sch,
+                                pipeline,
+                                std::size_t{8},
+                                counter(100),
+                                stage<stage_mode::parallel>(fail),
+                                stage<stage_mode::serial_in_order>(write)),
+                      std::runtime_error);
+
+    // Items before the failure are written in order, the failed item is skipped.
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      REQUIRE(out[i] != bad);
+      REQUIRE((i == 0 || out[i - 1] < out[i]));
+    }
+  }
+
+  auto throwing_source = [i = 0]() mutable -> std::optional<int> {
+    if (i == 10) {
+      throw std::runtime_error{"source"};
+    }
+    return i++;
+  };
+
+  int sum = 0;
+
+  REQUIRE_THROWS_AS(sync_wait(sch,
+                              pipeline,
+                              std::size_t{4},
+                              throwing_source,
+                              stage<stage_mode::serial_in_order>([&](int x) {
+                                sum += x;
+                              })),
+                    std::runtime_error);
+
+  REQUIRE(sum == 45);
+}
+
+// NOLINTEND
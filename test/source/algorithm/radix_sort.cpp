@@ -0,0 +1,142 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, ranges::sort, ranges::stable_sort
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for operator==, INTERNAL_CATCH_...
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <cstdint>                               // for int8_t, uint64_t, int64_t
+#include <random>                                // for mt19937_64
+#include <span>                                  // for span
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/radix_sort.hpp" // for radix_sort
+#include "libfork/core.hpp"                 // for sync_wait
+#include "libfork/schedule.hpp"             // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+template <typename T, typename Sch>
+void test_keys(Sch &&sch, auto make) {
+
+  std::mt19937_64 rng{42};
+
+  for (std::size_t len : {0UZ, 1UZ, 2UZ, 3UZ, 100UZ, 1'000UZ, 50'000UZ}) {
+    for (std::ptrdiff_t m : {1, 7, 1'000, 100'000}) {
+
+      if (static_cast<std::ptrdiff_t>(len) > 1'000 * m) {
+        continue; // Too many tiny chunks, each has a histogram.
+      }
+
+      std::vector<T> v(len);
+
+      for (auto &&x : v) {
+        x = make(rng);
+      }
+
+      auto expect = v;
+      std::ranges::sort(expect);
+
+      sync_wait(sch, lf::radix_sort, v, m);
+      REQUIRE(v == expect);
+    }
+  }
+}
+
+struct record {
+  double key;
+  std::size_t index;
+};
+
+template <typename Sch>
+void test(Sch &&sch) {
+
+  std::span<int> oops;
+
+  sync_wait(sch, lf::radix_sort, oops);
+  sync_wait(sch, lf::radix_sort, oops.begin(), oops.end(), 10);
+
+  test_keys<unsigned>(sch, [](auto &rng) {
+    return static_cast<unsigned>(rng());
+  });
+
+  test_keys<std::int8_t>(sch, [](auto &rng) {
+    return static_cast<std::int8_t>(rng());
+  });
+
+  test_keys<std::int64_t>(sch, [](auto &rng) {
+    return static_cast<std::int64_t>(rng());
+  });
+
+  // Small range, most of the passes are skipped.
+  test_keys<std::uint64_t>(sch, [](auto &rng) {
+    return rng() % 300;
+  });
+
+  test_keys<float>(sch, [](auto &rng) {
+    return static_cast<float>(static_cast<std::int64_t>(rng() % 2'000'001) - 1'000'000) / 7.0F;
+  });
+
+  test_keys<double>(sch, [](auto &rng) {
+    return static_cast<double>(static_cast<std::int64_t>(rng())) * 1e-300;
+  });
+
+  // Stability and projections.
+  std::vector<record> r;
+
+  for (std::size_t i = 0; i < 20'000; ++i) {
+    r.push_back({static_cast<double>(static_cast<int>(i * 7919 % 41) - 20), i});
+  }
+
+  auto expect = r;
+  std::ranges::stable_sort(expect, {}, &record::key);
+
+  sync_wait(sch, lf::radix_sort, r.begin(), r.end(), 1'000, &record::key);
+
+  for (std::size_t i = 0; i < r.size(); ++i) {
+    REQUIRE(r[i].key == expect[i].key);
+    REQUIRE(r[i].index == expect[i].index);
+  }
+
+  // Not trivially copyable.
+  std::vector<std::string> s;
+
+  for (int i = 0; i < 10'000; ++i) {
+    s.push_back(std::to_string(i * 7919 % 10'007));
+  }
+
+  auto s_expect = s;
+  std::ranges::stable_sort(s_expect, {}, &std::string::size);
+
+  sync_wait(sch, lf::radix_sort, s, 500, &std::string::size);
+  REQUIRE(s == s_expect);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("radix_sort", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+  test(make_scheduler<TestType>());
+}
+
+// NOLINTEND
@@ -0,0 +1,102 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, max
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for operator==, INTERNAL_CATCH_...
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for plus, identity
+#include <optional>                              // for operator==, nullopt
+#include <span>                                  // for span
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/reduce.hpp" // for reduce
+#include "libfork/core.hpp"             // for sync_wait
+#include "libfork/schedule.hpp"         // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+template <typename Sch>
+void test(Sch &&sch) {
+
+  std::span<int> oops;
+
+  REQUIRE(sync_wait(sch, reduce, oops, std::plus<>{}) == std::nullopt);
+  REQUIRE(sync_wait(sch, reduce, oops.begin(), oops.end(), 10, std::plus<>{}) == std::nullopt);
+
+  std::vector<long> v;
+
+  constexpr long n = 10'000;
+
+  for (long i = 1; i <= n; i++) {
+    v.push_back(i);
+  }
+
+  constexpr long correct = n * (n + 1) / 2;
+
+  auto doubled = [](long x) {
+    return 2 * x;
+  };
+
+  auto max = [](long a, long b) {
+    return std::max(a, b);
+  };
+
+  REQUIRE(sync_wait(sch, reduce, v, std::plus<>{}) == correct);
+  REQUIRE(sync_wait(sch, reduce, v.begin(), v.end(), std::plus<>{}, doubled) == 2 * correct);
+
+  for (long m : {1, 3, 100, 300, 20'000}) {
+    for (int rep = 0; rep < 10; ++rep) {
+      REQUIRE(sync_wait(sch, reduce, v, m, std::plus<>{}) == correct);
+      REQUIRE(sync_wait(sch, reduce, v.begin(), v.end(), m, std::plus<>{}, doubled) == 2 * correct);
+      REQUIRE(sync_wait(sch, reduce, v, m, max) == n);
+    }
+  }
+
+  for (std::size_t len = 1; len < 10; ++len) {
+    REQUIRE(sync_wait(sch, reduce, std::span(v.data(), len), 2, std::plus<>{}) == long(len * (len + 1) / 2));
+  }
+
+  auto thrower = [](long a, long b) -> long {
+    if (b == n / 2) {
+      throw std::runtime_error{"reduce"};
+    }
+    return a + b;
+  };
+
+  REQUIRE_THROWS_AS(sync_wait(sch, reduce, v, 100, thrower), std::runtime_error);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("reduce", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+  test(make_scheduler<TestType>());
+}
+
+TEMPLATE_TEST_CASE("reduce oversubscribed", "[algorithm][template]", busy_pool, lazy_pool) {
+  // More workers than the table has slots, some workers will share an accumulator.
+  test(TestType{2 * std::thread::hardware_concurrency() + 3});
+}
+
+// NOLINTEND
@@ -2,15 +2,16 @@
 #include <algorithm>                             // for min
 #include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
 #include <catch2/catch_test_macros.hpp>          // for operator<=, operator==, INTERNAL_CATCH_...
-#include <concepts>                              // for constructible_from, same_as
+#include <concepts>                              // for constructible_from, same_as, invocable
 #include <cstddef>                               // for size_t
 #include <functional>                            // for plus, identity, multiplies
 #include <limits>                                // for numeric_limits
 #include <numeric>                               // for inclusive_scan
 #include <random>                                // for random_device, uniform_int_distribution
+#include <stdexcept>                             // for runtime_error
 #include <string>                                // for string, operator+, basic_string
 #include <thread>                                // for thread
-#include <type_traits>                           // for type_identity
+#include <type_traits>                           // for type_identity, is_arithmetic_v
 #include <utility>                               // for cmp_greater, forward
 #include <vector>                                // for operator==, vector
 
@@ -46,6 +47,25 @@ auto random_vec(std::type_identity<int>, std::size_t n) -> std::vector<int> {
   return out;
 }
 
+/**
+ * Small integral values, exactly representable by floating point partial sums.
+ */
+template <typename T>
+  requires std::is_arithmetic_v<T>
+auto random_vec(std::type_identity<T>, std::size_t n) -> std::vector<T> {
+
+  std::vector<T> out(n);
+
+  lf::xoshiro rng{lf::seed, std::random_device{}};
+  std::uniform_int_distribution<int> dist{0, 1'000};
+
+  for (auto &&elem : out) {
+    elem = static_cast<T>(dist(rng));
+  }
+
+  return out;
+}
+
 auto random_vec(std::type_identity<std::string>, std::size_t n) -> std::vector<std::string> {
 
   std::vector<std::string> out(n);
@@ -102,7 +122,7 @@ void test(Sch &&sch, F bop, Proj proj, Check check) {
         break;
       }
 
-      // Test all eight overloads
+      // Test all sixteen overloads
 
       // std::cout << "n: " << n << " chunk: " << chunk << '\n';
 
@@ -156,6 +176,49 @@ void test(Sch &&sch, F bop, Proj proj, Check check) {
             REQUIRE(out == out_ok);
           }
         }
+        /* [iterator,lazy,output] */ {
+          std::vector<T> out(in.size());
+          lf::sync_wait(sch, lf::scan, in.begin(), in.end(), out.begin(), lf::lazy_split_t{chunk}, bop, proj);
+          REQUIRE(out == out_ok);
+        }
+        /* [iterator,lazy,in_place] */ {
+          std::vector<T> out = in;
+          lf::sync_wait(sch, lf::scan, out.begin(), out.end(), lf::lazy_split_t{chunk}, bop, proj);
+          REQUIRE(out == out_ok);
+        }
+        /* [range,lazy,output] */ {
+          std::vector<T> out(in.size());
+          lf::sync_wait(sch, lf::scan, in, out.begin(), lf::lazy_split, bop, proj);
+          REQUIRE(out == out_ok);
+        }
+        /* [range,lazy,in_place] */ {
+          std::vector<T> out = in;
+          lf::sync_wait(sch, lf::scan, out, lf::lazy_split_t{chunk}, bop, proj);
+          REQUIRE(out == out_ok);
+        }
+        if constexpr (std::invocable<F &, T, T> && std::invocable<Proj &, T &>) {
+          /* [iterator,single_pass,output] */ {
+            std::vector<T> out(in.size());
+            lf::sync_wait(
+                sch, lf::scan, in.begin(), in.end(), out.begin(), lf::single_pass_t{chunk}, bop, proj);
+            REQUIRE(out == out_ok);
+          }
+          /* [iterator,single_pass,in_place] */ {
+            std::vector<T> out = in;
+            lf::sync_wait(sch, lf::scan, out.begin(), out.end(), lf::single_pass_t{chunk}, bop, proj);
+            REQUIRE(out == out_ok);
+          }
+          /* [range,single_pass,output] */ {
+            std::vector<T> out(in.size());
+            lf::sync_wait(sch, lf::scan, in, out.begin(), lf::single_pass, bop, proj);
+            REQUIRE(out == out_ok);
+          }
+          /* [range,single_pass,in_place] */ {
+            std::vector<T> out = in;
+            lf::sync_wait(sch, lf::scan, out, lf::single_pass_t{chunk}, bop, proj);
+            REQUIRE(out == out_ok);
+          }
+        }
       }
     }
   }
@@ -243,3 +306,49 @@ TEMPLATE_TEST_CASE("scan <int> (co, co)", "[scan][template]", unit_pool, busy_po
     test<int>(make_scheduler<TestType>(), coro_plus, coro_doubler, check(std::plus{}, doubler));
   }
 }
+
+TEMPLATE_TEST_CASE("scan vectorized leaves", "[scan][template]", unit_pool, busy_pool, lazy_pool) {
+  SECTION("<unsigned> (+), (id)") {
+    test<unsigned>(
+        make_scheduler<TestType>(), std::plus{}, std::identity{}, check(std::plus{}, std::identity{}));
+  }
+  SECTION("<unsigned> (*), (id)") {
+    test<unsigned>(make_scheduler<TestType>(),
+                   std::multiplies{},
+                   std::identity{},
+                   check(std::multiplies{}, std::identity{}));
+  }
+  SECTION("<long long> (+), (id)") {
+    test<long long>(make_scheduler<TestType>(),
+                    std::plus<long long>{},
+                    std::identity{},
+                    check(std::plus{}, std::identity{}));
+  }
+  SECTION("<double> (+), (id)") {
+    test<double>(
+        make_scheduler<TestType>(), std::plus{}, std::identity{}, check(std::plus{}, std::identity{}));
+  }
+}
+
+TEMPLATE_TEST_CASE("scan single pass exceptions", "[scan][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  auto thrower = [](int a, int b) -> int {
+    if (b == 42) {
+      throw std::runtime_error{"scan"};
+    }
+    return a + b;
+  };
+
+  for (std::size_t n : {2UZ, 100UZ, 10'000UZ}) {
+
+    std::vector<int> v(n, 1);
+
+    v[n / 2] = 42;
+
+    for (std::ptrdiff_t chunk : {1, 7, 100}) {
+      REQUIRE_THROWS_AS(sync_wait(sch, lf::scan, v, lf::single_pass_t{chunk}, thrower), std::runtime_error);
+    }
+  }
+}
@@ -0,0 +1,122 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, ranges::is_sorted, ranges::stable_sort
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for operator==, INTERNAL_CATCH_...
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for ranges::greater
+#include <random>                                // for mt19937, uniform_int_distribution
+#include <span>                                  // for span
+#include <stdexcept>                             // for runtime_error
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <utility>                               // for pair
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/sort.hpp" // for sort, stable_sort
+#include "libfork/core.hpp"           // for sync_wait
+#include "libfork/schedule.hpp"       // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+auto random_vec(std::size_t n, int max) -> std::vector<int> {
+
+  std::mt19937 rng{static_cast<unsigned>(n)};
+  std::uniform_int_distribution<int> dist{0, max};
+
+  std::vector<int> v(n);
+
+  for (auto &&x : v) {
+    x = dist(rng);
+  }
+
+  return v;
+}
+
+template <typename Sch>
+void test(Sch &&sch) {
+
+  std::span<int> oops;
+
+  sync_wait(sch, lf::sort, oops);
+  sync_wait(sch, lf::stable_sort, oops.begin(), oops.end(), 10);
+
+  for (std::size_t len : {1UZ, 2UZ, 3UZ, 10UZ, 100UZ, 1'000UZ, 20'000UZ}) {
+    for (std::ptrdiff_t m : {1, 3, 100, 5'000}) {
+
+      auto v = random_vec(len, 1'000);
+      auto w = v;
+
+      sync_wait(sch, lf::sort, v, m);
+      REQUIRE(std::ranges::is_sorted(v));
+
+      sync_wait(sch, lf::sort, w.begin(), w.end(), m, std::ranges::greater{});
+      REQUIRE(std::ranges::is_sorted(w, std::ranges::greater{}));
+
+      // Stability, sort (key, original index) pairs by key only.
+      std::vector<std::pair<int, std::size_t>> p;
+
+      for (std::size_t i = 0; auto x : random_vec(len, 10)) {
+        p.emplace_back(x, i++);
+      }
+
+      sync_wait(sch, lf::stable_sort, p, m, std::ranges::less{}, &std::pair<int, std::size_t>::first);
+      REQUIRE(std::ranges::is_sorted(p));
+    }
+  }
+
+  // Default cutoff and a type that is not trivially copyable.
+  std::vector<std::string> s;
+
+  for (int x : random_vec(30'000, 100'000)) {
+    s.push_back(std::to_string(x));
+  }
+
+  auto expect = s;
+  std::ranges::stable_sort(expect, std::ranges::less{}, &std::string::size);
+
+  sync_wait(sch, lf::stable_sort, s, std::ranges::less{}, &std::string::size);
+  REQUIRE(s == expect);
+
+  sync_wait(sch, lf::sort, s.begin(), s.end(), 100);
+  REQUIRE(std::ranges::is_sorted(s));
+
+  auto v = random_vec(10'000, 1'000);
+
+  auto thrower = [](int a, int b) -> bool {
+    if (a == 500 || b == 500) {
+      throw std::runtime_error{"sort"};
+    }
+    return a < b;
+  };
+
+  REQUIRE_THROWS_AS(sync_wait(sch, lf::sort, v, 100, thrower), std::runtime_error);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("sort", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+  test(make_scheduler<TestType>());
+}
+
+// NOLINTEND
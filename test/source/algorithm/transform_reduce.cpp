@@ -0,0 +1,147 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, ranges::max, ranges::min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for operator==, INTERNAL_CATCH_...
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for plus, negate
+#include <limits>                                // for numeric_limits
+#include <numeric>                               // for transform_reduce
+#include <span>                                  // for span
+#include <stdexcept>                             // for runtime_error
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/transform_reduce.hpp" // for transform_reduce
+#include "libfork/core.hpp"                       // for sync_wait
+#include "libfork/schedule.hpp"                   // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+template <typename Sch>
+void test(Sch &&sch) {
+
+  std::span<long> oops;
+
+  REQUIRE(sync_wait(sch, lf::transform_reduce, oops, oops.begin(), 7L) == 7);
+  REQUIRE(sync_wait(sch, lf::transform_reduce, oops, 10, 7L, std::plus<>{}, std::negate<>{}) == 7);
+
+  auto square = [](long x) {
+    return x * x;
+  };
+
+  auto diff = [](long x, double y) {
+    return static_cast<double>(x) - y;
+  };
+
+  auto max = [](long a, long b) {
+    return std::ranges::max(a, b);
+  };
+
+  for (long n : {1, 2, 3, 10, 1'000, 20'000}) {
+
+    std::vector<long> x;
+    std::vector<double> y;
+
+    for (long i = 1; i <= n; i++) {
+      x.push_back(i % 97);
+      y.push_back(static_cast<double>(i % 13));
+    }
+
+    long dot = std::transform_reduce(x.begin(), x.end(), y.begin(), 3L);
+    long ss = std::transform_reduce(x.begin(), x.end(), 3L, std::plus<>{}, square);
+    double dd = std::transform_reduce(x.begin(), x.end(), y.begin(), 0.5, std::plus<>{}, diff);
+
+    REQUIRE(sync_wait(sch, lf::transform_reduce, x, y.begin(), 3L) == dot);
+    REQUIRE(sync_wait(sch, lf::transform_reduce, x.begin(), x.end(), 3L, std::plus<>{}, square) == ss);
+
+    for (long m : {1, 3, 100, 5'000}) {
+      // Binary.
+      REQUIRE(sync_wait(sch, lf::transform_reduce, x.begin(), x.end(), y.begin(), m, 3L) == dot);
+      REQUIRE(sync_wait(sch, lf::transform_reduce, x, y.begin(), m, 3L) == dot);
+      REQUIRE(sync_wait(sch, lf::transform_reduce, x, y.begin(), m, 0.5, std::plus<>{}, diff) == dd);
+      REQUIRE(sync_wait(sch, lf::transform_reduce, x.begin(), x.end(), y.begin(), m, 0.5, std::plus<>{}, diff) ==
+              dd);
+      // Unary.
+      REQUIRE(sync_wait(sch, lf::transform_reduce, x, m, 3L, std::plus<>{}, square) == ss);
+      REQUIRE(sync_wait(sch, lf::transform_reduce, x.begin(), x.end(), m, 3L, std::plus<>{}, square) == ss);
+      REQUIRE(sync_wait(sch, lf::transform_reduce, x, m, 0L, max, square) == square(std::min(n, 96L)));
+    }
+  }
+
+  // Floating point min/max skip a NaN unless it is the accumulator, one chunk must match a serial reduction.
+  std::vector<double> u(100, 0.0);
+
+  u[1] = std::numeric_limits<double>::quiet_NaN();
+  u[17] = 5;
+  u[33] = -5;
+
+  auto id = [](double d) {
+    return d;
+  };
+
+  REQUIRE(sync_wait(sch, lf::transform_reduce, u, 100, -100.0, std::ranges::max, id) == 5);
+  REQUIRE(sync_wait(sch, lf::transform_reduce, u, 100, 100.0, std::ranges::min, id) == -5);
+
+  // Not an arithmetic type, the order of the operands must be preserved.
+  std::vector<int> s;
+
+  for (int i = 0; i < 1'000; ++i) {
+    s.push_back(i % 10);
+  }
+
+  auto to_string = [](int i) {
+    return std::to_string(i);
+  };
+
+  std::string expect = "x";
+
+  for (int i : s) {
+    expect += to_string(i);
+  }
+
+  REQUIRE(sync_wait(sch, lf::transform_reduce, s, 7, std::string{"x"}, std::plus<>{}, to_string) == expect);
+
+  std::vector<long> v(10'000, 1);
+
+  v[5'000] = 42;
+
+  auto thrower = [](long a) -> long {
+    if (a == 42) {
+      throw std::runtime_error{"transform_reduce"};
+    }
+    return a;
+  };
+
+  REQUIRE_THROWS_AS(sync_wait(sch, lf::transform_reduce, v, 100, 0L, std::plus<>{}, thrower),
+                    std::runtime_error);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("transform_reduce", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+  test(make_scheduler<TestType>());
+}
+
+// NOLINTEND
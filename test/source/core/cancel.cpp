@@ -0,0 +1,198 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic_int
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <thread>                                // for thread, yield
+#include <utility>                               // for move
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, call, join, cancelled, request_stop
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+inline constexpr auto polling = [](auto) -> task<bool> {
+  //
+  bool before = co_await cancelled();
+
+  co_await request_stop();
+
+  bool after = co_await cancelled();
+
+  co_return !before && after;
+};
+
+/**
+ * @brief Visit `2^n` leaves, the first leaf cancels the tree.
+ */
+inline constexpr auto tree = [](auto tree, int n, std::atomic_int *leaves) -> task<> {
+  //
+  if (n == 0) {
+    if (leaves->fetch_add(1) == 0) {
+      co_await request_stop();
+    }
+    co_return;
+  }
+
+  co_await lf::fork(tree)(n - 1, leaves);
+  co_await lf::fork(tree)(n - 1, leaves);
+
+  co_await lf::join;
+};
+
+inline constexpr auto count = [](auto, int *out) -> task<> {
+  ++*out;
+  co_return;
+};
+
+inline constexpr auto not_elided = [](auto) -> task<int> {
+  //
+  co_await request_stop();
+
+  int forked = 0;
+  int called = 0;
+  int synced = 0;
+
+  co_await lf::fork(count)(&forked);
+  co_await lf::call(count)(&called);
+  co_await lf::dispatch<tag::fork, modifier::sync>(count)(&synced);
+
+  co_await lf::join;
+
+  co_return 100 * forked + 10 * called + synced;
+};
+
+inline constexpr auto forty_two = [](auto) -> task<int> {
+  co_return 42;
+};
+
+inline constexpr auto returns_not_elided = [](auto) -> task<int> {
+  //
+  co_await request_stop();
+
+  int forked = 0;
+
+  co_await lf::fork(&forked, forty_two)();
+  co_await lf::join;
+
+  co_return forked;
+};
+
+inline constexpr auto spin = [](auto spin, std::atomic_int *started) -> task<> {
+  //
+  started->store(1);
+
+  int n = 0;
+
+  while (!co_await cancelled()) {
+    co_await lf::fork(count)(&n);
+    co_await lf::join;
+  }
+};
+
+inline constexpr auto root_spin = [](auto, std::atomic_int *started) -> task<bool> {
+  //
+  co_await lf::call(spin)(started);
+
+  co_return co_await cancelled();
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Cancel polling", "[cancel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, polling));
+  }
+}
+
+TEMPLATE_TEST_CASE("Cancel prunes forks", "[cancel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    std::atomic_int leaves = 0;
+
+    sync_wait(sch, tree, 12, &leaves);
+
+    REQUIRE(leaves > 0);
+    REQUIRE(leaves <= 1 << 12);
+
+    if constexpr (std::same_as<TestType, unit_pool>) {
+      // Single threaded, everything after the first leaf is elided.
+      REQUIRE(leaves == 1);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Cancel does not elide calls", "[cancel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, not_elided) == 11);
+  }
+}
+
+TEMPLATE_TEST_CASE("Cancel keeps returning forks", "[cancel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, returns_not_elided) == 42);
+  }
+}
+
+TEMPLATE_TEST_CASE("Cancel via future", "[cancel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    std::atomic_int started = 0;
+
+    auto fut = schedule(sch, root_spin, &started);
+
+    REQUIRE(!fut.stop_requested());
+
+    while (started.load() == 0) {
+      std::this_thread::yield();
+    }
+
+    fut.request_stop();
+
+    REQUIRE(fut.stop_requested());
+    REQUIRE(fut.get());
+
+    auto moved = std::move(fut);
+
+    REQUIRE_THROWS_AS(fut.request_stop(), broken_future);
+  }
+}
+
+// NOLINTEND
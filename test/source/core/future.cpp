@@ -0,0 +1,277 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic_bool
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <chrono>                                // for milliseconds, steady_clock
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/core.hpp"     // for schedule, future, when_all, when_any, task, worker_context
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+inline constexpr auto fib = [](auto fib, int n) -> task<int> {
+  //
+  if (n < 2) {
+    co_return n;
+  }
+
+  int a, b;
+
+  co_await lf::fork(&a, fib)(n - 1);
+  co_await lf::call(&b, fib)(n - 2);
+
+  co_await lf::join;
+
+  co_return a + b;
+};
+
+inline constexpr auto twice = [](auto, int x) -> task<int> {
+  co_return 2 * x;
+};
+
+inline constexpr auto unit = [](auto) -> task<> {
+  co_return;
+};
+
+inline constexpr auto answer = [](auto) -> task<int> {
+  co_return 42;
+};
+
+inline constexpr auto sum_all = [](auto, std::vector<future<int>> all) -> task<int> {
+  //
+  int acc = 0;
+
+  for (auto &&fut : all) {
+    if (!fut.is_ready()) {
+      co_return -1;
+    }
+    acc += fut.get();
+  }
+
+  co_return acc;
+};
+
+inline constexpr auto gated = [](auto, std::atomic_bool *gate) -> task<int> {
+  //
+  while (!gate->load()) {
+    std::this_thread::yield();
+  }
+
+  co_return 1;
+};
+
+inline constexpr auto thrower = [](auto) -> task<int> {
+  throw std::runtime_error{"thrower"};
+  co_return 0;
+};
+
+inline constexpr auto await_future = [](auto self, future<int> *fut) -> task<int> {
+  //
+  worker_context *home = self.context();
+
+  int x = co_await *fut;
+
+  co_return self.context() == home ? x : -1;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Future then", "[future][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    future<int> fut = schedule(sch, fib, 20).then(sch, twice).then(sch, twice);
+
+    REQUIRE(fut.get() == 4 * 6765);
+  }
+
+  // Attached after completion.
+  for (int i = 0; i < 10; ++i) {
+
+    future<int> fut = schedule(sch, fib, 5);
+
+    fut.wait();
+
+    REQUIRE(std::move(fut).then(sch, twice).get() == 10);
+  }
+
+  REQUIRE(schedule(sch, unit).then(sch, answer).get() == 42);
+}
+
+TEMPLATE_TEST_CASE("Future then exception", "[future][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  future<int> fut = schedule(sch, thrower).then(sch, twice);
+
+  REQUIRE_THROWS_AS(fut.get(), std::runtime_error);
+}
+
+TEMPLATE_TEST_CASE("Future wait_for", "[future][template]", unit_pool, busy_pool, lazy_pool) {
+
+  using namespace std::chrono_literals;
+
+  auto sch = make_scheduler<TestType>();
+
+  std::atomic_bool gate = false;
+
+  future<int> fut = schedule(sch, gated, &gate);
+
+  REQUIRE(!fut.wait_for(1ms));
+  REQUIRE(!fut.wait_until(std::chrono::steady_clock::now() + 1ms));
+
+  gate = true;
+
+  REQUIRE(fut.wait_for(10s));
+  REQUIRE(fut.wait_for(0ms));
+  REQUIRE(fut.get() == 1);
+}
+
+TEMPLATE_TEST_CASE("Future co_await", "[future][template]", busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+  auto other = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    std::atomic_bool gate = false;
+
+    future<int> fut = schedule(other, gated, &gate);
+    future<int> res = schedule(sch, await_future, &fut);
+
+    gate = true;
+
+    REQUIRE(res.get() == 1);
+  }
+
+  // Already complete.
+  future<int> fut = schedule(other, fib, 10);
+
+  fut.wait();
+
+  REQUIRE(sync_wait(sch, await_future, &fut) == 55);
+
+  // Exceptions are rethrown in the awaiting task.
+  future<int> bad = schedule(other, thrower);
+
+  REQUIRE_THROWS_AS(sync_wait(sch, await_future, &bad), std::runtime_error);
+}
+
+TEMPLATE_TEST_CASE("Future when_all", "[future][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    std::vector<future<int>> futs;
+
+    for (int j = 0; j < 20; ++j) {
+      futs.push_back(schedule(sch, fib, j));
+    }
+
+    future<int> sum = when_all(std::move(futs)).then(sch, sum_all);
+
+    REQUIRE(sum.get() == 10946 - 1);
+  }
+
+  REQUIRE(when_all(std::vector<future<int>>{}).get().empty());
+}
+
+TEMPLATE_TEST_CASE("Future when_any", "[future][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    std::vector<future<int>> futs;
+
+    futs.push_back(schedule(sch, fib, 25));
+    futs.push_back(schedule(sch, fib, 1));
+
+    when_any_result<int> any = when_any(std::move(futs)).get();
+
+    REQUIRE(any.index < 2);
+    REQUIRE(any.futures.size() == 2);
+    REQUIRE(any.futures[any.index].is_ready());
+
+    REQUIRE(any.futures[0].get() == 75025);
+    REQUIRE(any.futures[1].get() == 1);
+  }
+}
+
+TEMPLATE_TEST_CASE("Future when_any loser", "[future][template]", busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+  auto other = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    std::atomic_bool gate = false;
+
+    std::vector<future<int>> futs;
+
+    futs.push_back(schedule(other, gated, &gate));
+    futs.push_back(schedule(sch, fib, 1));
+
+    when_any_result<int> any = when_any(std::move(futs)).get();
+
+    REQUIRE(any.index == 1);
+
+    // The loser no longer has a continuation attached, hence it can be awaited.
+    future<int> res = schedule(sch, await_future, &any.futures[0]);
+
+    gate = true;
+
+    REQUIRE(res.get() == 1);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+
+    std::atomic_bool gate = false;
+
+    std::vector<future<int>> futs;
+
+    futs.push_back(schedule(sch, fib, 1));
+    futs.push_back(schedule(other, gated, &gate));
+
+    when_any_result<int> any = when_any(std::move(futs)).get();
+
+    REQUIRE(any.index == 0);
+
+    future<int> res = std::move(any.futures[1]).then(sch, twice);
+
+    gate = true;
+
+    REQUIRE(res.get() == 2);
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,112 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread, yield
+
+#include "libfork/core.hpp"     // for on, sync_wait, task
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  return T{std::min(4U, std::thread::hardware_concurrency())};
+}
+
+constexpr auto sync_fib(int n) -> int {
+  if (n < 2) {
+    return n;
+  }
+  return sync_fib(n - 1) + sync_fib(n - 2);
+}
+
+inline constexpr auto fib = [](auto fib, int n) -> task<int> {
+  //
+  if (n < 2) {
+    co_return n;
+  }
+
+  int a, b;
+
+  co_await lf::fork(&a, fib)(n - 1);
+  co_await lf::call(&b, fib)(n - 2);
+
+  co_await lf::join;
+
+  co_return a + b;
+};
+
+inline constexpr auto thrower = [](auto) -> task<int> {
+  throw std::runtime_error{"thrower"};
+  co_return 0;
+};
+
+/**
+ * @brief Call fib on `other` (from a fork) and check we come back to the same worker.
+ */
+template <typename Sch>
+inline constexpr auto hop = [](auto hop, Sch *other, int n) -> task<bool> {
+  //
+  if (n < 10) {
+
+    worker_context *home = hop.context();
+
+    int x = co_await lf::on(*other, fib, n);
+
+    co_return x == sync_fib(n) && hop.context() == home;
+  }
+
+  bool a, b;
+
+  co_await lf::fork(&a, hop)(other, n - 1);
+  co_await lf::call(&b, hop)(other, n - 2);
+
+  co_await lf::join;
+
+  co_return a && b;
+};
+
+template <typename Sch>
+inline constexpr auto hop_throws = [](auto self, Sch *other) -> task<bool> {
+  //
+  worker_context *home = self.context();
+
+  try {
+    co_await lf::on(*other, thrower);
+  } catch (std::runtime_error const &) {
+    co_return self.context() == home;
+  }
+
+  co_return false;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("On another pool", "[on][template]", busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+  auto other = make_scheduler<TestType>();
+
+  unit_pool unit;
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, hop<TestType>, &other, 15));
+    REQUIRE(sync_wait(sch, hop<unit_pool>, &unit, 15));
+    REQUIRE(sync_wait(sch, hop_throws<TestType>, &other));
+  }
+}
+
+// NOLINTEND
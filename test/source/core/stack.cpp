@@ -0,0 +1,165 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                    // for min
+#include <atomic>                       // for atomic
+#include <catch2/catch_test_macros.hpp> // for operator""_catch_sr, operator==, AssertionHandler
+#include <thread>                       // for thread
+#include <vector>                       // for vector
+
+#include "libfork/core.hpp"     // for sync_wait, task
+#include "libfork/schedule.hpp" // for lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+using impl::stack;
+
+TEST_CASE("Root cache round trip", "[stack]") {
+
+  stack::stacklet *root = nullptr;
+
+  {
+    stack cached{stack::root_cache_t{}};
+    root = cached.top();
+  }
+
+  // The cache is LIFO hence, the next cached stack reuses the stacklet.
+  stack cached{stack::root_cache_t{}};
+
+  REQUIRE(cached.top() == root);
+}
+
+TEST_CASE("Plain stacks bypass the root cache", "[stack]") {
+
+  stack::stacklet *root = nullptr;
+
+  {
+    stack cached{stack::root_cache_t{}};
+    root = cached.top();
+  }
+
+  // A worker's stack must not draw from the cache.
+  stack plain;
+
+  REQUIRE(plain.top() != root);
+
+  stack cached{stack::root_cache_t{}};
+
+  REQUIRE(cached.top() == root);
+}
+
+TEST_CASE("Adopting a stacklet retires to the root cache", "[stack]") {
+
+  stack worker;
+
+  stack::stacklet *retired = worker.top();
+
+  stack::stacklet *migrant = nullptr;
+
+  {
+    // The submitter's replacement is drawn from (and returned to) the cache.
+    stack submitter{stack::root_cache_t{}};
+    migrant = submitter.release();
+  }
+
+  worker.adopt(migrant);
+
+  REQUIRE(worker.top() != retired);
+
+  stack cached{stack::root_cache_t{}};
+
+  REQUIRE(cached.top() == retired);
+}
+
+TEST_CASE("Only submitted stacklets are adopted", "[stack]") {
+
+  stack::stacklet *root = nullptr;
+
+  {
+    stack cached{stack::root_cache_t{}};
+    root = cached.top();
+  }
+
+  // A task that context-switched off a worker's stack.
+  stack other;
+
+  stack::stacklet *frag = other.release();
+
+  REQUIRE_FALSE(stack::submitted(frag));
+
+  // The worker's retired stacklet is freed, the cache is untouched.
+  stack worker;
+
+  worker = stack{frag};
+
+  REQUIRE(worker.top() == frag);
+
+  stack::stacklet *migrant = nullptr;
+
+  {
+    stack submitter{stack::root_cache_t{}};
+
+    REQUIRE(submitter.top() == root);
+
+    migrant = submitter.release();
+  }
+
+  REQUIRE(stack::submitted(migrant));
+
+  worker.adopt(migrant);
+
+  REQUIRE_FALSE(stack::submitted(migrant));
+
+  // Only adopting the submitted stacklet retired the worker's stacklet to the cache.
+  stack cached{stack::root_cache_t{}};
+
+  REQUIRE(cached.top() == frag);
+}
+
+namespace {
+
+inline constexpr auto ident = [](auto, int x) -> task<int> {
+  co_return x;
+};
+
+} // namespace
+
+TEST_CASE("Concurrent submissions share the root cache", "[stack]") {
+
+  lazy_pool pool{std::min(4U, std::thread::hardware_concurrency())};
+
+  std::atomic<int> errors = 0;
+
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&pool, &errors, i] {
+      for (int j = 0; j < 1000; ++j) {
+        if (sync_wait(pool, ident, i + j) != i + j) {
+          ++errors;
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(errors == 0);
+
+  unit_pool unit;
+
+  for (int j = 0; j < 100; ++j) {
+    REQUIRE(sync_wait(unit, ident, j) == j);
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,129 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic_int
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <chrono>                                // for milliseconds
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <memory>                                // for unique_ptr, make_unique
+#include <stdexcept>                             // for runtime_error
+#include <string>                                // for string
+#include <thread>                                // for thread, sleep_for
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, join
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool, blocking
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+using namespace std::chrono_literals;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+inline constexpr auto same_worker = [](auto self) -> task<bool> {
+  //
+  auto *before = self.context();
+
+  std::thread::id id = co_await blocking([] {
+    return std::this_thread::get_id();
+  });
+
+  co_return self.context() == before && id != std::this_thread::get_id();
+};
+
+inline constexpr auto args = [](auto) -> task<bool> {
+  //
+  std::string str = co_await blocking(
+      [](std::string const &s, std::unique_ptr<int> p) {
+        return s + std::to_string(*p);
+      },
+      std::string{"libfork"},
+      std::make_unique<int>(4));
+
+  co_return str == "libfork4";
+};
+
+inline constexpr auto throws = [](auto) -> task<bool> {
+  //
+  try {
+    co_await blocking([] {
+      throw std::runtime_error{"blocking"};
+    });
+  } catch (std::runtime_error const &) {
+    co_return true;
+  }
+
+  co_return false;
+};
+
+inline constexpr auto block_many = [](auto block_many, std::atomic_int *count, int n) -> task<> {
+  //
+  if (n == 0) {
+    co_return;
+  }
+
+  co_await lf::fork(block_many)(count, n - 1);
+
+  co_await blocking([count] {
+    std::this_thread::sleep_for(1ms);
+    count->fetch_add(1);
+  });
+
+  co_await lf::join;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Blocking same worker", "[blocking][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, same_worker));
+  }
+}
+
+TEMPLATE_TEST_CASE("Blocking arguments", "[blocking][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, args));
+}
+
+TEMPLATE_TEST_CASE("Blocking exception", "[blocking][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, throws));
+}
+
+TEMPLATE_TEST_CASE("Blocking many", "[blocking][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 5; ++i) {
+    std::atomic_int count = 0;
+    sync_wait(sch, block_many, &count, 100);
+    REQUIRE(count == 100);
+  }
+}
+
+// NOLINTEND
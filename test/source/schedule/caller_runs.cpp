@@ -0,0 +1,188 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <chrono>                                // for milliseconds
+#include <cstddef>                               // for size_t
+#include <memory>                                // for make_shared, shared_ptr
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread, sleep_for
+#include <vector>                                // for vector
+
+#include "libfork/core.hpp"     // for task, fork, call, join, schedule_in_worker
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, blocking, mutex
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  return T{std::min(4U, std::thread::hardware_concurrency())};
+}
+
+inline constexpr auto fib = [](auto fib, int n) -> task<int> {
+  //
+  if (n < 2) {
+    co_return n;
+  }
+
+  int a, b;
+
+  co_await lf::fork(&a, fib)(n - 1);
+  co_await lf::call(&b, fib)(n - 2);
+
+  co_await lf::join;
+
+  co_return a + b;
+};
+
+/**
+ * @brief Suspend every leaf such that it is resumed via a submission to the worker it suspended on.
+ */
+inline constexpr auto sleepy = [](auto sleepy, int n) -> task<int> {
+  //
+  if (n == 0) {
+    co_return co_await lf::blocking([] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return 1;
+    });
+  }
+
+  int a, b;
+
+  co_await lf::fork(&a, sleepy)(n - 1);
+  co_await lf::call(&b, sleepy)(n - 1);
+
+  co_await lf::join;
+
+  co_return a + b;
+};
+
+inline constexpr auto locked_add = [](auto locked_add, lf::mutex *mtx, int *count, int width) -> task<> {
+  //
+  if (width > 1) {
+    co_await lf::fork(locked_add)(mtx, count, width / 2);
+    co_await lf::call(locked_add)(mtx, count, width - width / 2);
+    co_await lf::join;
+    co_return;
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    co_await mtx->lock();
+    LF_DEFER { mtx->unlock(); };
+    *count += 1;
+  }
+};
+
+inline constexpr auto thrower = [](auto) -> task<int> {
+  throw std::runtime_error{"thrower"};
+  co_return 0;
+};
+
+inline constexpr auto nested = [](auto, busy_pool *pool) -> task<bool> {
+  try {
+    pool->caller_runs(fib, 5);
+  } catch (schedule_in_worker const &) {
+    co_return true;
+  }
+  co_return false;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Caller runs", "[caller_runs][template]", busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sch.caller_runs(fib, 20) == 6765);
+  }
+
+  REQUIRE(sch.caller_runs(sleepy, 5) == 32);
+
+  lf::mutex mtx;
+  int count = 0;
+
+  sch.caller_runs(locked_add, &mtx, &count, 32);
+
+  REQUIRE(count == 32 * 100);
+
+  REQUIRE_THROWS_AS(sch.caller_runs(thrower), std::runtime_error);
+}
+
+TEMPLATE_TEST_CASE("Caller runs concurrently", "[caller_runs][template]", busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  // More than the number of guest slots, some callers will fall back to sync_wait.
+  constexpr std::size_t callers = 12;
+
+  std::vector<int> results(callers, 0);
+  std::vector<std::thread> threads;
+
+  for (std::size_t i = 0; i < callers; ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < 10; ++j) {
+        results[i] += sch.caller_runs(fib, 15);
+      }
+    });
+  }
+
+  for (auto &&thread : threads) {
+    thread.join();
+  }
+
+  for (int result : results) {
+    REQUIRE(result == 10 * 610);
+  }
+}
+
+TEST_CASE("Destroy an unsubmitted root", "[caller_runs]") {
+
+  auto witness = std::make_shared<int>(0);
+
+  impl::future_shared_state<void> state;
+
+  submit_handle root = nullptr;
+
+  impl::launch_root(
+      &state,
+      [&](submit_handle node) noexcept {
+        root = node;
+      },
+      [](auto, std::shared_ptr<int>) -> task<> {
+        co_return;
+      },
+      witness);
+
+  // The root's frame holds a copy.
+  REQUIRE(witness.use_count() == 2);
+
+  impl::destroy_root(root);
+
+  REQUIRE(witness.use_count() == 1);
+
+  // The thread can still submit.
+  busy_pool sch{1};
+
+  REQUIRE(sync_wait(sch, fib, 10) == 55);
+}
+
+TEST_CASE("Caller runs in worker", "[caller_runs]") {
+
+  busy_pool sch{1};
+
+  REQUIRE(sync_wait(sch, nested, &sch));
+}
+
+// NOLINTEND
@@ -0,0 +1,293 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <memory>                                // for unique_ptr, make_unique
+#include <optional>                              // for optional
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, join
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool, channel
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+/**
+ * @brief `width` producers each send `1, ..., n` then the channel is closed.
+ */
+inline constexpr auto produce = [](auto produce, channel<long> *ch, int width, long n, bool root) -> task<> {
+  //
+  if (width > 1) {
+    co_await lf::fork(produce)(ch, width / 2, n, false);
+    co_await lf::call(produce)(ch, width - width / 2, n, false);
+    co_await lf::join;
+  } else {
+    for (long i = 1; i <= n; ++i) {
+      if (!co_await ch->send(i)) {
+        co_return;
+      }
+    }
+  }
+
+  if (root) {
+    ch->close();
+  }
+};
+
+/**
+ * @brief `width` consumers drain the channel, returns the sum of the received values.
+ */
+inline constexpr auto consume = [](auto consume, channel<long> *ch, int width) -> task<long> {
+  //
+  if (width > 1) {
+
+    long a, b;
+
+    co_await lf::fork(&a, consume)(ch, width / 2);
+    co_await lf::call(&b, consume)(ch, width - width / 2);
+    co_await lf::join;
+
+    co_return a + b;
+  }
+
+  long sum = 0;
+
+  while (std::optional<long> val = co_await ch->recv()) {
+    sum += *val;
+  }
+
+  co_return sum;
+};
+
+inline constexpr auto produce_consume =
+    [](auto, channel<long> *ch, int producers, int consumers, long n) -> task<long> {
+  //
+  long sum;
+
+  co_await lf::fork(&sum, consume)(ch, consumers);
+  co_await lf::call(produce)(ch, producers, n, true);
+
+  co_await lf::join;
+
+  co_return sum;
+};
+
+inline constexpr auto move_only = [](auto) -> task<bool> {
+  //
+  channel<std::unique_ptr<int>> ch{1};
+
+  bool sent = co_await ch.send(std::make_unique<int>(7));
+
+  std::optional<std::unique_ptr<int>> val = co_await ch.recv();
+
+  co_return sent && val && **val == 7;
+};
+
+inline constexpr auto drain = [](auto) -> task<bool> {
+  //
+  channel<int> ch{4};
+
+  bool ok = co_await ch.send(1) && co_await ch.send(2);
+
+  ch.close();
+
+  ok = ok && !co_await ch.send(3);
+
+  std::optional<int> a = co_await ch.recv();
+  std::optional<int> b = co_await ch.recv();
+  std::optional<int> c = co_await ch.recv();
+
+  co_return ok && a == 1 && b == 2 && !c;
+};
+
+/**
+ * @brief A value whose move throws if it is armed.
+ */
+struct fragile {
+
+  explicit fragile(bool arm) : armed{arm} {}
+
+  fragile(fragile &&other) : armed{other.armed} {
+    if (armed) {
+      throw std::runtime_error{"fragile"};
+    }
+  }
+
+  auto operator=(fragile &&other) -> fragile & {
+    if (other.armed) {
+      throw std::runtime_error{"fragile"};
+    }
+    armed = other.armed;
+    return *this;
+  }
+
+  bool armed;
+};
+
+inline constexpr auto recv_fragile = [](auto, channel<fragile> *ch) -> task<bool> {
+  std::optional<fragile> val = co_await ch->recv();
+  co_return val && !val->armed;
+};
+
+inline constexpr auto throwing_send = [](auto) -> task<bool> {
+  //
+  channel<fragile> ch{1};
+
+  bool received = false;
+
+  // On a unit_pool the receiver suspends before the parent continues.
+  co_await lf::fork(&received, recv_fragile)(&ch);
+
+  bool threw = false;
+
+  try {
+    impl::ignore_t{} = ch.try_send(fragile{true});
+  } catch (std::runtime_error const &) {
+    threw = true;
+  }
+
+  // The receiver must still be waiting.
+  bool sent = ch.try_send(fragile{false});
+
+  co_await lf::join;
+
+  co_return threw && sent && received;
+};
+
+/**
+ * @brief A value whose move inspects the channel it is sent through, this deadlocks if moved under the lock.
+ */
+struct reentrant {
+
+  // Type-erased as channel<reentrant> cannot be named before reentrant is complete.
+  explicit reentrant(void *chan) : ch{chan} {}
+
+  reentrant(reentrant &&other) : ch{other.ch} { probe(); }
+
+  auto operator=(reentrant &&other) -> reentrant & {
+    ch = other.ch;
+    probe();
+    return *this;
+  }
+
+  void probe() const { impl::ignore_t{} = static_cast<channel<reentrant> *>(ch)->closed(); }
+
+  void *ch;
+};
+
+inline constexpr auto recv_reentrant = [](auto, channel<reentrant> *ch) -> task<bool> {
+  std::optional<reentrant> val = co_await ch->recv();
+  co_return val && val->ch == ch;
+};
+
+inline constexpr auto reentrant_moves = [](auto) -> task<bool> {
+  //
+  channel<reentrant> ch{1};
+
+  bool received = false;
+
+  // Handed directly to a suspended receiver.
+  co_await lf::fork(&received, recv_reentrant)(&ch);
+
+  bool sent = co_await ch.send(reentrant{&ch});
+
+  co_await lf::join;
+
+  // Through the buffer.
+  bool buffered = ch.try_send(reentrant{&ch});
+
+  std::optional<reentrant> val = ch.try_recv();
+
+  co_return received && sent && buffered && val && val->ch == &ch;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Channel bounded", "[channel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t cap : {std::size_t{1}, std::size_t{2}, std::size_t{16}}) {
+    for (int i = 0; i < 5; ++i) {
+      channel<long> ch{cap};
+      REQUIRE(sync_wait(sch, produce_consume, &ch, 8, 8, 100L) == 8 * 50 * 101);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Channel unbounded", "[channel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 5; ++i) {
+    channel<long> ch;
+    REQUIRE(sync_wait(sch, produce_consume, &ch, 4, 3, 1000L) == 4 * 500 * 1001);
+  }
+}
+
+TEMPLATE_TEST_CASE("Channel move only", "[channel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, move_only));
+}
+
+TEMPLATE_TEST_CASE("Channel close and drain", "[channel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, drain));
+}
+
+TEST_CASE("Channel throwing send keeps the receiver", "[channel]") {
+
+  unit_pool sch;
+
+  REQUIRE(sync_wait(sch, throwing_send));
+}
+
+TEST_CASE("Channel moves values outside the lock", "[channel]") {
+
+  unit_pool sch;
+
+  REQUIRE(sync_wait(sch, reentrant_moves));
+}
+
+TEST_CASE("Channel try", "[channel]") {
+
+  channel<int> ch{1};
+
+  REQUIRE(!ch.try_recv());
+  REQUIRE(ch.try_send(1));
+  REQUIRE(!ch.try_send(2));
+  REQUIRE(ch.try_recv() == 1);
+
+  ch.close();
+
+  REQUIRE(ch.closed());
+  REQUIRE(!ch.try_send(3));
+}
+
+// NOLINTEND
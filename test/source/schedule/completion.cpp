@@ -0,0 +1,146 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <chrono>                                // for microseconds
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <exception>                             // for make_exception_ptr
+#include <mutex>                                 // for mutex, lock_guard
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread, sleep_for
+#include <vector>                                // for vector
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, call, join, worker_context
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool, completion
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+/**
+ * @brief Mimics a C library that reports completion via a callback on its own threads.
+ */
+class library {
+ public:
+  using callback = void (*)(void *ctx, int result);
+
+  void start(int input, callback cb, void *ctx) {
+    std::lock_guard lock{m_mutex};
+    m_threads.emplace_back([=] {
+      std::this_thread::sleep_for(std::chrono::microseconds(input % 7 * 50));
+      cb(ctx, 2 * input);
+    });
+  }
+
+  ~library() {
+    for (auto &&thread : m_threads) {
+      thread.join();
+    }
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::vector<std::thread> m_threads;
+};
+
+inline constexpr auto doubled = [](auto self, library *lib, int n) -> task<bool> {
+  //
+  worker_context *home = self.context();
+
+  lf::completion<int> done;
+
+  auto callback = [](void *ctx, int result) {
+    static_cast<lf::completion<int> *>(ctx)->set_value(result);
+  };
+
+  lib->start(n, callback, &done);
+
+  int result = co_await done.wait();
+
+  co_return result == 2 * n && self.context() == home;
+};
+
+inline constexpr auto fan_out = [](auto fan_out, library *lib, int lo, int hi) -> task<bool> {
+  //
+  bool a, b;
+
+  if (hi - lo == 1) {
+    co_await lf::call(&a, doubled)(lib, lo);
+    co_await lf::join;
+    co_return a;
+  }
+
+  int mid = lo + (hi - lo) / 2;
+
+  co_await lf::fork(&a, fan_out)(lib, lo, mid);
+  co_await lf::call(&b, fan_out)(lib, mid, hi);
+
+  co_await lf::join;
+
+  co_return a && b;
+};
+
+inline constexpr auto already_set = [](auto) -> task<int> {
+  //
+  lf::completion<int> done;
+
+  done.set_value(42);
+
+  co_return co_await done.wait();
+};
+
+inline constexpr auto unit_and_throw = [](auto) -> task<int> {
+  //
+  lf::completion<> unit;
+
+  std::thread{[&] {
+    unit.set_value();
+  }}.detach();
+
+  co_await unit.wait();
+
+  lf::completion<int> bad;
+
+  std::thread{[&] {
+    bad.set_exception(std::make_exception_ptr(std::runtime_error{"bad"}));
+  }}.detach();
+
+  co_return co_await bad.wait();
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Completion", "[completion][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 5; ++i) {
+    library lib;
+    REQUIRE(sync_wait(sch, fan_out, &lib, 0, 64));
+  }
+
+  REQUIRE(sync_wait(sch, already_set) == 42);
+
+  REQUIRE_THROWS_AS(sync_wait(sch, unit_and_throw), std::runtime_error);
+}
+
+// NOLINTEND
@@ -0,0 +1,261 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#ifdef __linux__
+
+  #include <algorithm>                             // for min, equal
+  #include <array>                                 // for array
+  #include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+  #include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+  #include <chrono>                                // for milliseconds
+  #include <concepts>                              // for constructible_from
+  #include <cstddef>                               // for size_t, byte
+  #include <cstdint>                               // for int64_t
+  #include <cstdlib>                               // for mkstemp, getenv
+  #include <netinet/in.h>                          // for sockaddr_in, htonl, INADDR_LOOPBACK
+  #include <poll.h>                                // for POLLIN
+  #include <span>                                  // for as_bytes, as_writable_bytes
+  #include <sys/socket.h>                          // for socket, bind, listen, connect
+  #include <system_error>                          // for system_error
+  #include <thread>                                // for thread, sleep_for
+  #include <unistd.h>                              // for pipe, close, unlink, write
+
+  #include "libfork/core.hpp"     // for sync_wait, task, fork, join
+  #include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool, io_read, io_write...
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+inline constexpr std::array<char, 13> k_msg = {
+    'h', 'e', 'l', 'l', 'o', ' ', 'l', 'i', 'b', 'f', 'o', 'r', 'k',
+};
+
+inline constexpr auto reader = [](auto, int fd, std::span<char> buf, std::int64_t off) -> task<std::int64_t> {
+  co_return co_await io_read(fd, std::as_writable_bytes(buf), off);
+};
+
+inline constexpr auto writer =
+    [](auto, int fd, std::span<char const> buf, std::int64_t off) -> task<std::int64_t> {
+  co_return co_await io_write(fd, std::as_bytes(buf), off);
+};
+
+inline constexpr auto pipe_round_trip = [](auto) -> task<bool> {
+  //
+  std::array<int, 2> fds;
+
+  if (::pipe(fds.data()) != 0) {
+    co_return false;
+  }
+
+  std::array<char, k_msg.size()> buf{};
+
+  std::int64_t r = 0;
+  std::int64_t w = 0;
+
+  co_await lf::fork(&r, reader)(fds[0], buf, -1);
+  co_await lf::call(&w, writer)(fds[1], k_msg, -1);
+
+  co_await lf::join;
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+
+  co_return r == std::ssize(k_msg) && w == std::ssize(k_msg) && buf == k_msg;
+};
+
+inline constexpr auto shared_readers = [](auto) -> task<bool> {
+  //
+  std::array<int, 2> fds;
+
+  if (::pipe(fds.data()) != 0) {
+    co_return false;
+  }
+
+  std::array<char, 1> a{};
+  std::array<char, 1> b{};
+
+  std::int64_t ra = 0;
+  std::int64_t rb = 0;
+
+  co_await lf::fork(&ra, reader)(fds[0], a, -1);
+  co_await lf::fork(&rb, reader)(fds[0], b, -1);
+
+  // Both readers may be woken by the first byte, the one that loses the race must not block.
+  bool ok = ::write(fds[1], k_msg.data(), 1) == 1;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  ok = ok && ::write(fds[1], k_msg.data() + 1, 1) == 1;
+
+  co_await lf::join;
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+
+  co_return ok && ra == 1 && rb == 1 && a[0] + b[0] == k_msg[0] + k_msg[1];
+};
+
+inline constexpr auto file_round_trip = [](auto) -> task<bool> {
+  //
+  char path[] = "/tmp/libfork_io_XXXXXX";
+
+  int fd = ::mkstemp(path);
+
+  if (fd < 0) {
+    co_return false;
+  }
+
+  ::unlink(path);
+
+  std::array<char, k_msg.size()> buf{};
+
+  std::int64_t w = co_await io_write(fd, std::as_bytes(std::span{k_msg}), 0);
+  std::int64_t s = co_await io_fsync(fd);
+  std::int64_t r = co_await io_read(fd, std::as_writable_bytes(std::span{buf}), 0);
+
+  ::close(fd);
+
+  co_return w == std::ssize(k_msg) && s == 0 && r == std::ssize(k_msg) && buf == k_msg;
+};
+
+inline constexpr auto poll_pipe = [](auto) -> task<bool> {
+  //
+  std::array<int, 2> fds;
+
+  if (::pipe(fds.data()) != 0) {
+    co_return false;
+  }
+
+  bool ok = ::write(fds[1], k_msg.data(), 1) == 1;
+
+  std::int64_t events = co_await io_poll(fds[0], POLLIN);
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+
+  co_return ok && (events & POLLIN) != 0;
+};
+
+inline constexpr auto accept_one = [](auto) -> task<bool> {
+  //
+  int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+
+  socklen_t len = sizeof(addr);
+
+  if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr *>(&addr), len) != 0 ||
+      ::listen(listener, 1) != 0 || ::getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &len) != 0) {
+    co_return false;
+  }
+
+  int client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  bool connected = ::connect(client, reinterpret_cast<sockaddr *>(&addr), len) == 0;
+
+  std::int64_t accepted = co_await io_accept(listener);
+
+  ::close(static_cast<int>(accepted));
+  ::close(client);
+  ::close(listener);
+
+  co_return connected && accepted >= 0;
+};
+
+inline constexpr auto bad_fd = [](auto) -> task<bool> {
+  //
+  std::array<char, 1> buf{};
+
+  try {
+    co_await io_read(-1, std::as_writable_bytes(std::span{buf}));
+  } catch (std::system_error const &) {
+    co_return true;
+  }
+
+  co_return false;
+};
+
+} // namespace
+
+TEST_CASE("IO backend", "[io]") {
+  // The test suite is run a second time with LF_NO_IO_URING set, to cover the epoll backend.
+  if (std::getenv("LF_NO_IO_URING") != nullptr) {
+    REQUIRE_FALSE(impl::io().uses_uring());
+  }
+}
+
+TEMPLATE_TEST_CASE("IO pipe", "[io][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 50; ++i) {
+    REQUIRE(sync_wait(sch, pipe_round_trip));
+  }
+}
+
+TEMPLATE_TEST_CASE("IO shared pipe", "[io][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, shared_readers));
+  }
+}
+
+TEMPLATE_TEST_CASE("IO file", "[io][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, file_round_trip));
+  }
+}
+
+TEMPLATE_TEST_CASE("IO poll", "[io][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, poll_pipe));
+  }
+}
+
+TEMPLATE_TEST_CASE("IO accept", "[io][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, accept_one));
+  }
+}
+
+TEMPLATE_TEST_CASE("IO error", "[io][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, bad_fd));
+}
+
+// NOLINTEND
+
+#endif
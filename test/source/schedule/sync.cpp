@@ -0,0 +1,243 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic_int
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, join, LF_DEFER
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool, mutex, semaphore, latch, barrier
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+/**
+ * @brief Non-atomic increments of `*count` under the lock, `n` times in each of `width` tasks.
+ */
+inline constexpr auto locked_add = [](auto locked_add, lf::mutex *mtx, int *count, int width) -> task<> {
+  //
+  if (width > 1) {
+    co_await lf::fork(locked_add)(mtx, count, width / 2);
+    co_await lf::call(locked_add)(mtx, count, width - width / 2);
+    co_await lf::join;
+    co_return;
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    co_await mtx->lock();
+    LF_DEFER { mtx->unlock(); };
+    *count += 1;
+  }
+};
+
+/**
+ * @brief Track the maximum number of tasks concurrently holding a permit.
+ */
+inline constexpr auto bounded =
+    [](auto bounded, lf::semaphore *sem, std::atomic_int *in, std::atomic_int *max, int width) -> task<> {
+  //
+  if (width > 1) {
+    co_await lf::fork(bounded)(sem, in, max, width / 2);
+    co_await lf::call(bounded)(sem, in, max, width - width / 2);
+    co_await lf::join;
+    co_return;
+  }
+
+  for (int i = 0; i < 10; ++i) {
+
+    co_await sem->acquire();
+
+    int now = in->fetch_add(1) + 1;
+
+    for (int old = max->load(); old < now && !max->compare_exchange_weak(old, now);) {
+    }
+
+    std::this_thread::yield();
+
+    in->fetch_sub(1);
+
+    sem->release();
+  }
+};
+
+/**
+ * @brief Every task arrives then checks that all the others arrived before it was resumed.
+ */
+inline constexpr auto arrive =
+    [](auto arrive, lf::latch *lat, std::atomic_int *before, int width) -> task<bool> {
+  //
+  if (width > 1) {
+
+    bool a, b;
+
+    co_await lf::fork(&a, arrive)(lat, before, width / 2);
+    co_await lf::call(&b, arrive)(lat, before, width - width / 2);
+    co_await lf::join;
+
+    co_return a && b;
+  }
+
+  before->fetch_add(1);
+
+  co_await lat->arrive_and_wait();
+
+  co_return lat->try_wait();
+};
+
+inline constexpr auto latch_wait = [](auto, lf::latch *lat, int n) -> task<bool> {
+  //
+  std::atomic_int before = 0;
+
+  bool ok;
+
+  co_await lf::fork(&ok, arrive)(lat, &before, n);
+
+  co_await lat->wait();
+
+  bool all = before.load() == n;
+
+  co_await lf::join;
+
+  co_return ok && all;
+};
+
+/**
+ * @brief `width` tasks step through `steps` BSP phases, each phase reads then writes its own slot.
+ */
+inline constexpr auto phases = [](auto phases, lf::barrier *bar, std::vector<int> *slots, int lo, int hi,
+                                  int steps) -> task<bool> {
+  //
+  if (hi - lo > 1) {
+
+    bool a, b;
+    int mid = lo + (hi - lo) / 2;
+
+    co_await lf::fork(&a, phases)(bar, slots, lo, mid, steps);
+    co_await lf::call(&b, phases)(bar, slots, mid, hi, steps);
+    co_await lf::join;
+
+    co_return a && b;
+  }
+
+  bool ok = true;
+
+  for (int step = 0; step < steps; ++step) {
+
+    // Every slot must have reached this phase.
+    for (int slot : *slots) {
+      ok = ok && slot == step;
+    }
+
+    co_await bar->arrive_and_wait();
+
+    (*slots)[static_cast<std::size_t>(lo)] = step + 1;
+
+    co_await bar->arrive_and_wait();
+  }
+
+  co_return ok;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Sync mutex", "[sync][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    lf::mutex mtx;
+    int count = 0;
+
+    sync_wait(sch, locked_add, &mtx, &count, 64);
+
+    REQUIRE(count == 64 * 100);
+    REQUIRE(mtx.try_lock());
+  }
+}
+
+TEMPLATE_TEST_CASE("Sync semaphore", "[sync][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    lf::semaphore sem{2};
+    std::atomic_int in = 0;
+    std::atomic_int max = 0;
+
+    sync_wait(sch, bounded, &sem, &in, &max, 32);
+
+    REQUIRE(in == 0);
+    REQUIRE(max <= 2);
+    REQUIRE(sem.try_acquire());
+    REQUIRE(sem.try_acquire());
+    REQUIRE(!sem.try_acquire());
+  }
+}
+
+TEMPLATE_TEST_CASE("Sync latch", "[sync][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+    lf::latch lat{32};
+    REQUIRE(sync_wait(sch, latch_wait, &lat, 32));
+  }
+}
+
+TEMPLATE_TEST_CASE("Sync barrier", "[sync][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 10; ++i) {
+
+    constexpr int width = 16;
+
+    lf::barrier bar{width};
+    std::vector<int> slots(width, 0);
+
+    REQUIRE(sync_wait(sch, phases, &bar, &slots, 0, width, 20));
+  }
+}
+
+TEST_CASE("Sync last arrival does not suspend", "[sync]") {
+
+  lf::latch lat{3};
+
+  lat.count_down();
+
+  REQUIRE(!lat.arrive_and_wait().await_ready());
+  REQUIRE(lat.arrive_and_wait(2).await_ready());
+  REQUIRE(lat.try_wait());
+
+  lf::barrier bar{1};
+
+  // Every phase is completed by its only arrival.
+  REQUIRE(bar.arrive_and_wait().await_ready());
+  REQUIRE(bar.arrive_and_wait().await_ready());
+}
+
+// NOLINTEND
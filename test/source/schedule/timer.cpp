@@ -0,0 +1,102 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
+#include <chrono>                                // for steady_clock, milliseconds
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <thread>                                // for thread
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, join
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool, resume_after, resume_at
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+using namespace std::chrono_literals;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+inline constexpr auto nap = []<typename Sch>(auto, Sch *sch, std::chrono::milliseconds ms) -> task<bool> {
+  //
+  auto start = std::chrono::steady_clock::now();
+
+  co_await resume_after(sch, ms);
+
+  co_return std::chrono::steady_clock::now() - start >= ms;
+};
+
+inline constexpr auto sleep_many = []<typename Sch>(auto sleep_many, Sch *sch, int n) -> task<int> {
+  //
+  if (n == 0) {
+    co_return 0;
+  }
+
+  bool a, b;
+  int c;
+
+  co_await lf::fork(&a, nap)(sch, std::chrono::milliseconds{n % 7});
+  co_await lf::fork(&c, sleep_many)(sch, n - 1);
+  co_await lf::call(&b, nap)(sch, std::chrono::milliseconds{(3 * n) % 5});
+
+  co_await lf::join;
+
+  co_return a + b + c;
+};
+
+inline constexpr auto past = []<typename Sch>(auto self, Sch *sch) -> task<bool> {
+  //
+  auto *before = self.context();
+
+  co_await resume_at(sch, std::chrono::steady_clock::now() - 1s);
+
+  co_return self.context() == before;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Timer resume_after", "[timer][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(sync_wait(sch, nap, &sch, 10ms));
+  }
+}
+
+TEMPLATE_TEST_CASE("Timer many", "[timer][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(sync_wait(sch, sleep_many, &sch, 50) == 100);
+  }
+}
+
+TEMPLATE_TEST_CASE("Timer past deadline", "[timer][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(sync_wait(sch, past, &sch));
+  }
+}
+
+// NOLINTEND